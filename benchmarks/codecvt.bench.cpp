@@ -0,0 +1,162 @@
+#include <codecvt>
+#include <locale>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+
+// UTF-8 text of roughly N bytes built by repeating a sample.
+static std::string makeUTF8(const char* sample, std::size_t N) {
+  std::string s;
+  while (s.size() < N)
+    s += sample;
+  return s;
+}
+
+static std::string getASCII(std::size_t N) {
+  return makeUTF8("The quick brown fox jumps over the lazy dog. ", N);
+}
+
+static std::string getLatin(std::size_t N) {
+  return makeUTF8("Le c\xC5\x93ur a ses raisons que la raison ne conna\xC3\xAEt "
+                  "point, d\xC3\xA9j\xC3\xA0 vu. ", N);
+}
+
+static std::string getCJK(std::size_t N) {
+  return makeUTF8("\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E\xE3\x81\xAE\xE6\x96"
+                  "\x87\xE7\xAB\xA0\xE3\x80\x82\xE4\xB8\xAD\xE6\x96\x87\xE3"
+                  "\x80\x82", N);
+}
+
+static std::string getEmoji(std::size_t N) {
+  return makeUTF8("ok \xF0\x9F\x98\x80\xF0\x9F\x91\x8D\xF0\x9F\x8E\x89 "
+                  "\xF0\x9F\x9A\x80!", N);
+}
+
+template <class Codecvt>
+struct Tag {};
+
+template <class Codecvt, class GenInput>
+void BM_CodecvtIn(benchmark::State& st, Tag<Codecvt>, GenInput gen) {
+  typedef typename Codecvt::intern_type InternT;
+  const Codecvt cvt;
+  const std::string in = gen(st.range(0));
+  std::vector<InternT> out(in.size());
+  while (st.KeepRunning()) {
+    std::mbstate_t state = std::mbstate_t();
+    const char* from_next;
+    InternT* to_next;
+    benchmark::DoNotOptimize(cvt.in(state, in.data(), in.data() + in.size(),
+                                    from_next, out.data(),
+                                    out.data() + out.size(), to_next));
+    benchmark::DoNotOptimize(out.data());
+  }
+  st.SetBytesProcessed(st.iterations() * in.size());
+}
+
+template <class Codecvt, class GenInput>
+void BM_CodecvtOut(benchmark::State& st, Tag<Codecvt>, GenInput gen) {
+  typedef typename Codecvt::intern_type InternT;
+  const Codecvt cvt;
+  const std::string utf8 = gen(st.range(0));
+  std::vector<InternT> in(utf8.size());
+  std::mbstate_t state = std::mbstate_t();
+  const char* from_next;
+  InternT* in_end;
+  cvt.in(state, utf8.data(), utf8.data() + utf8.size(), from_next,
+         in.data(), in.data() + in.size(), in_end);
+  std::string out(utf8.size(), '\0');
+  while (st.KeepRunning()) {
+    state = std::mbstate_t();
+    const InternT* in_next;
+    char* to_next;
+    benchmark::DoNotOptimize(cvt.out(state, in.data(), in_end, in_next,
+                                     &out[0], &out[0] + out.size(), to_next));
+    benchmark::DoNotOptimize(out.data());
+  }
+  st.SetBytesProcessed(st.iterations() * utf8.size());
+}
+
+template <class Codecvt, class GenInput>
+void BM_CodecvtLength(benchmark::State& st, Tag<Codecvt>, GenInput gen) {
+  const Codecvt cvt;
+  const std::string in = gen(st.range(0));
+  while (st.KeepRunning()) {
+    std::mbstate_t state = std::mbstate_t();
+    benchmark::DoNotOptimize(cvt.length(state, in.data(),
+                                        in.data() + in.size(), in.size()));
+  }
+  st.SetBytesProcessed(st.iterations() * in.size());
+}
+
+// codecvt<char16_t, char, mbstate_t> has a protected destructor.
+struct CodecvtUTF16 : std::codecvt<char16_t, char, std::mbstate_t> {};
+typedef std::codecvt_utf8<char32_t> CodecvtUTF8;
+typedef std::codecvt_utf8_utf16<char16_t> CodecvtUTF8UTF16;
+
+constexpr std::size_t TestNumBytes = 1 << 16;
+
+BENCHMARK_CAPTURE(BM_CodecvtIn, utf16_ascii, Tag<CodecvtUTF16>(), getASCII)
+    ->Arg(TestNumBytes);
+BENCHMARK_CAPTURE(BM_CodecvtIn, utf16_latin, Tag<CodecvtUTF16>(), getLatin)
+    ->Arg(TestNumBytes);
+BENCHMARK_CAPTURE(BM_CodecvtIn, utf16_cjk, Tag<CodecvtUTF16>(), getCJK)
+    ->Arg(TestNumBytes);
+BENCHMARK_CAPTURE(BM_CodecvtIn, utf16_emoji, Tag<CodecvtUTF16>(), getEmoji)
+    ->Arg(TestNumBytes);
+BENCHMARK_CAPTURE(BM_CodecvtOut, utf16_ascii, Tag<CodecvtUTF16>(), getASCII)
+    ->Arg(TestNumBytes);
+BENCHMARK_CAPTURE(BM_CodecvtOut, utf16_latin, Tag<CodecvtUTF16>(), getLatin)
+    ->Arg(TestNumBytes);
+BENCHMARK_CAPTURE(BM_CodecvtOut, utf16_cjk, Tag<CodecvtUTF16>(), getCJK)
+    ->Arg(TestNumBytes);
+BENCHMARK_CAPTURE(BM_CodecvtOut, utf16_emoji, Tag<CodecvtUTF16>(), getEmoji)
+    ->Arg(TestNumBytes);
+BENCHMARK_CAPTURE(BM_CodecvtLength, utf16_ascii, Tag<CodecvtUTF16>(), getASCII)
+    ->Arg(TestNumBytes);
+BENCHMARK_CAPTURE(BM_CodecvtLength, utf16_cjk, Tag<CodecvtUTF16>(), getCJK)
+    ->Arg(TestNumBytes);
+
+BENCHMARK_CAPTURE(BM_CodecvtIn, utf8_ascii, Tag<CodecvtUTF8>(), getASCII)
+    ->Arg(TestNumBytes);
+BENCHMARK_CAPTURE(BM_CodecvtIn, utf8_latin, Tag<CodecvtUTF8>(), getLatin)
+    ->Arg(TestNumBytes);
+BENCHMARK_CAPTURE(BM_CodecvtIn, utf8_cjk, Tag<CodecvtUTF8>(), getCJK)
+    ->Arg(TestNumBytes);
+BENCHMARK_CAPTURE(BM_CodecvtIn, utf8_emoji, Tag<CodecvtUTF8>(), getEmoji)
+    ->Arg(TestNumBytes);
+BENCHMARK_CAPTURE(BM_CodecvtOut, utf8_ascii, Tag<CodecvtUTF8>(), getASCII)
+    ->Arg(TestNumBytes);
+BENCHMARK_CAPTURE(BM_CodecvtOut, utf8_latin, Tag<CodecvtUTF8>(), getLatin)
+    ->Arg(TestNumBytes);
+BENCHMARK_CAPTURE(BM_CodecvtOut, utf8_cjk, Tag<CodecvtUTF8>(), getCJK)
+    ->Arg(TestNumBytes);
+BENCHMARK_CAPTURE(BM_CodecvtOut, utf8_emoji, Tag<CodecvtUTF8>(), getEmoji)
+    ->Arg(TestNumBytes);
+BENCHMARK_CAPTURE(BM_CodecvtLength, utf8_ascii, Tag<CodecvtUTF8>(), getASCII)
+    ->Arg(TestNumBytes);
+BENCHMARK_CAPTURE(BM_CodecvtLength, utf8_cjk, Tag<CodecvtUTF8>(), getCJK)
+    ->Arg(TestNumBytes);
+
+BENCHMARK_CAPTURE(BM_CodecvtIn, utf8_utf16_ascii, Tag<CodecvtUTF8UTF16>(), getASCII)
+    ->Arg(TestNumBytes);
+BENCHMARK_CAPTURE(BM_CodecvtIn, utf8_utf16_latin, Tag<CodecvtUTF8UTF16>(), getLatin)
+    ->Arg(TestNumBytes);
+BENCHMARK_CAPTURE(BM_CodecvtIn, utf8_utf16_cjk, Tag<CodecvtUTF8UTF16>(), getCJK)
+    ->Arg(TestNumBytes);
+BENCHMARK_CAPTURE(BM_CodecvtIn, utf8_utf16_emoji, Tag<CodecvtUTF8UTF16>(), getEmoji)
+    ->Arg(TestNumBytes);
+BENCHMARK_CAPTURE(BM_CodecvtOut, utf8_utf16_ascii, Tag<CodecvtUTF8UTF16>(), getASCII)
+    ->Arg(TestNumBytes);
+BENCHMARK_CAPTURE(BM_CodecvtOut, utf8_utf16_latin, Tag<CodecvtUTF8UTF16>(), getLatin)
+    ->Arg(TestNumBytes);
+BENCHMARK_CAPTURE(BM_CodecvtOut, utf8_utf16_cjk, Tag<CodecvtUTF8UTF16>(), getCJK)
+    ->Arg(TestNumBytes);
+BENCHMARK_CAPTURE(BM_CodecvtOut, utf8_utf16_emoji, Tag<CodecvtUTF8UTF16>(), getEmoji)
+    ->Arg(TestNumBytes);
+BENCHMARK_CAPTURE(BM_CodecvtLength, utf8_utf16_ascii, Tag<CodecvtUTF8UTF16>(), getASCII)
+    ->Arg(TestNumBytes);
+BENCHMARK_CAPTURE(BM_CodecvtLength, utf8_utf16_cjk, Tag<CodecvtUTF8UTF16>(), getCJK)
+    ->Arg(TestNumBytes);
+
+BENCHMARK_MAIN()
@@ -0,0 +1,72 @@
+#include <locale>
+#include <string>
+
+#include "benchmark/benchmark_api.h"
+
+// Mixed-case log-like text of N bytes with no control characters.
+static std::string getText(std::size_t N) {
+  const char sample[] = "2017-10-04 12:00:01 INFO Request GET /Index.html "
+                        "from 10.0.0.1 took 12ms; Status=OK ";
+  std::string s;
+  while (s.size() < N)
+    s += sample;
+  s.resize(N);
+  return s;
+}
+
+static void BM_CtypeToupper(benchmark::State& st) {
+  const std::ctype<char>& ct =
+      std::use_facet<std::ctype<char> >(std::locale::classic());
+  std::string s = getText(st.range(0));
+  while (st.KeepRunning()) {
+    ct.toupper(&s[0], s.data() + s.size());
+    benchmark::DoNotOptimize(s.data());
+  }
+  st.SetBytesProcessed(st.iterations() * s.size());
+}
+BENCHMARK(BM_CtypeToupper)->Range(1 << 10, 1 << 24);
+
+static void BM_CtypeTolower(benchmark::State& st) {
+  const std::ctype<char>& ct =
+      std::use_facet<std::ctype<char> >(std::locale::classic());
+  std::string s = getText(st.range(0));
+  while (st.KeepRunning()) {
+    ct.tolower(&s[0], s.data() + s.size());
+    benchmark::DoNotOptimize(s.data());
+  }
+  st.SetBytesProcessed(st.iterations() * s.size());
+}
+BENCHMARK(BM_CtypeTolower)->Range(1 << 10, 1 << 24);
+
+// Split the text into whitespace-separated tokens.
+static void BM_CtypeScanTokens(benchmark::State& st) {
+  const std::ctype<char>& ct =
+      std::use_facet<std::ctype<char> >(std::locale::classic());
+  const std::string s = getText(st.range(0));
+  const char* const end = s.data() + s.size();
+  while (st.KeepRunning()) {
+    std::size_t tokens = 0;
+    for (const char* p = ct.scan_not(std::ctype_base::space, s.data(), end);
+         p != end; p = ct.scan_not(std::ctype_base::space, p, end)) {
+      p = ct.scan_is(std::ctype_base::space, p, end);
+      ++tokens;
+    }
+    benchmark::DoNotOptimize(tokens);
+  }
+  st.SetBytesProcessed(st.iterations() * s.size());
+}
+BENCHMARK(BM_CtypeScanTokens)->Range(1 << 10, 1 << 24);
+
+// Look for a character that never occurs.
+static void BM_CtypeScanIsMiss(benchmark::State& st) {
+  const std::ctype<char>& ct =
+      std::use_facet<std::ctype<char> >(std::locale::classic());
+  const std::string s = getText(st.range(0));
+  while (st.KeepRunning())
+    benchmark::DoNotOptimize(
+        ct.scan_is(std::ctype_base::cntrl, s.data(), s.data() + s.size()));
+  st.SetBytesProcessed(st.iterations() * s.size());
+}
+BENCHMARK(BM_CtypeScanIsMiss)->Range(1 << 10, 1 << 24);
+
+BENCHMARK_MAIN()
@@ -0,0 +1,305 @@
+#include <algorithm>
+#include <cstdint>
+#include <experimental/algorithm>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+
+#ifdef _LIBCPP_VERSION
+#include <experimental/random>
+#endif
+
+// The cost of one value of an engine, with the sum of the values kept live so
+// that none of the calls are optimized away.
+template <class Engine>
+static void BM_Engine(benchmark::State& st) {
+  Engine e;
+  typename Engine::result_type sum = 0;
+  while (st.KeepRunning()) {
+    for (int i = 0; i < 1024; ++i)
+      sum += e();
+  }
+  benchmark::DoNotOptimize(sum);
+  st.SetItemsProcessed(st.iterations() * 1024);
+}
+BENCHMARK_TEMPLATE(BM_Engine, std::minstd_rand0);
+BENCHMARK_TEMPLATE(BM_Engine, std::minstd_rand);
+BENCHMARK_TEMPLATE(BM_Engine, std::mt19937);
+BENCHMARK_TEMPLATE(BM_Engine, std::mt19937_64);
+BENCHMARK_TEMPLATE(BM_Engine, std::ranlux24_base);
+BENCHMARK_TEMPLATE(BM_Engine, std::ranlux48_base);
+BENCHMARK_TEMPLATE(BM_Engine, std::ranlux24);
+BENCHMARK_TEMPLATE(BM_Engine, std::ranlux48);
+BENCHMARK_TEMPLATE(BM_Engine, std::knuth_b);
+
+// Filling a block of values at once, which libc++ does through the __generate
+// member of the engines that have one.
+template <class Engine, class Iter>
+static void fill_engine(Engine& e, Iter first, Iter last) {
+#ifdef _LIBCPP_VERSION
+  std::__generate_random(e, first, last);
+#else
+  std::generate(first, last, std::ref(e));
+#endif
+}
+
+template <class Engine>
+static void BM_EngineFill(benchmark::State& st) {
+  Engine e;
+  std::vector<typename Engine::result_type> v(1024);
+  while (st.KeepRunning()) {
+    fill_engine(e, v.begin(), v.end());
+    benchmark::DoNotOptimize(v.data());
+  }
+  st.SetItemsProcessed(st.iterations() * 1024);
+}
+BENCHMARK_TEMPLATE(BM_EngineFill, std::minstd_rand);
+BENCHMARK_TEMPLATE(BM_EngineFill, std::mt19937);
+BENCHMARK_TEMPLATE(BM_EngineFill, std::mt19937_64);
+BENCHMARK_TEMPLATE(BM_EngineFill, std::ranlux24);
+BENCHMARK_TEMPLATE(BM_EngineFill, std::ranlux48);
+BENCHMARK_TEMPLATE(BM_EngineFill, std::knuth_b);
+
+static void BM_RandomDevice(benchmark::State& st) {
+  std::random_device rd;
+  unsigned sum = 0;
+  while (st.KeepRunning()) {
+    for (int i = 0; i < 64; ++i)
+      sum += rd();
+  }
+  benchmark::DoNotOptimize(sum);
+  st.SetItemsProcessed(st.iterations() * 64);
+}
+BENCHMARK(BM_RandomDevice);
+
+static void BM_RandomDeviceFill(benchmark::State& st) {
+  std::random_device rd;
+  std::vector<unsigned> v(1024);
+  while (st.KeepRunning()) {
+#ifdef _LIBCPP_VERSION
+    rd.__generate(v.begin(), v.end());
+#else
+    std::generate(v.begin(), v.end(), std::ref(rd));
+#endif
+    benchmark::DoNotOptimize(v.data());
+  }
+  st.SetItemsProcessed(st.iterations() * 1024);
+}
+BENCHMARK(BM_RandomDeviceFill);
+
+// The same for a distribution drawing on the engine.
+template <class Engine, class Dist>
+static void BM_EngineDist(benchmark::State& st) {
+  Engine e;
+  Dist d;
+  typename Dist::result_type sum = 0;
+  while (st.KeepRunning()) {
+    for (int i = 0; i < 1024; ++i)
+      sum += d(e);
+  }
+  benchmark::DoNotOptimize(sum);
+  st.SetItemsProcessed(st.iterations() * 1024);
+}
+BENCHMARK_TEMPLATE(BM_EngineDist, std::mt19937, std::uniform_real_distribution<>);
+BENCHMARK_TEMPLATE(BM_EngineDist, std::mt19937_64, std::uniform_real_distribution<>);
+BENCHMARK_TEMPLATE(BM_EngineDist, std::mt19937, std::normal_distribution<>);
+
+// Each distribution of <random> with typical parameters, on mt19937.
+template <class Dist>
+static void BM_Distribution(benchmark::State& st, Dist d) {
+  std::mt19937 e;
+  double sum = 0;
+  while (st.KeepRunning()) {
+    for (int i = 0; i < 1024; ++i)
+      sum += d(e);
+  }
+  benchmark::DoNotOptimize(sum);
+  st.SetItemsProcessed(st.iterations() * 1024);
+}
+BENCHMARK_CAPTURE(BM_Distribution, uniform_int,
+                  std::uniform_int_distribution<>(0, 99));
+BENCHMARK_CAPTURE(BM_Distribution, uniform_int_64,
+                  std::uniform_int_distribution<long long>(0, 1ll << 40));
+BENCHMARK_CAPTURE(BM_Distribution, uniform_real,
+                  std::uniform_real_distribution<>(0, 1));
+BENCHMARK_CAPTURE(BM_Distribution, bernoulli, std::bernoulli_distribution(0.3));
+BENCHMARK_CAPTURE(BM_Distribution, geometric, std::geometric_distribution<>(0.1));
+BENCHMARK_CAPTURE(BM_Distribution, negative_binomial,
+                  std::negative_binomial_distribution<>(5, 0.3));
+BENCHMARK_CAPTURE(BM_Distribution, exponential,
+                  std::exponential_distribution<>(1));
+BENCHMARK_CAPTURE(BM_Distribution, gamma_small_alpha,
+                  std::gamma_distribution<>(0.5, 1));
+BENCHMARK_CAPTURE(BM_Distribution, gamma, std::gamma_distribution<>(2.5, 1));
+BENCHMARK_CAPTURE(BM_Distribution, weibull, std::weibull_distribution<>(2, 1));
+BENCHMARK_CAPTURE(BM_Distribution, extreme_value,
+                  std::extreme_value_distribution<>(0, 1));
+BENCHMARK_CAPTURE(BM_Distribution, normal, std::normal_distribution<>(0, 1));
+BENCHMARK_CAPTURE(BM_Distribution, normal_float,
+                  std::normal_distribution<float>(0, 1));
+BENCHMARK_CAPTURE(BM_Distribution, lognormal, std::lognormal_distribution<>(0, 1));
+BENCHMARK_CAPTURE(BM_Distribution, chi_squared, std::chi_squared_distribution<>(4));
+BENCHMARK_CAPTURE(BM_Distribution, cauchy, std::cauchy_distribution<>(0, 1));
+BENCHMARK_CAPTURE(BM_Distribution, fisher_f, std::fisher_f_distribution<>(5, 10));
+BENCHMARK_CAPTURE(BM_Distribution, student_t, std::student_t_distribution<>(5));
+BENCHMARK_CAPTURE(BM_Distribution, discrete,
+                  std::discrete_distribution<>({1, 2, 3, 4}));
+BENCHMARK_CAPTURE(BM_Distribution, piecewise_linear,
+                  std::piecewise_linear_distribution<>({0, 1, 2, 3},
+                      [](double x) { return x + 1; }));
+
+// Filling a block of values at once, which libc++ does through the __generate
+// member of the distributions that have one.
+template <class Dist>
+static void BM_DistributionFill(benchmark::State& st, Dist d) {
+  std::mt19937 e;
+  std::vector<typename Dist::result_type> v(1024);
+  while (st.KeepRunning()) {
+#ifdef _LIBCPP_VERSION
+    d.__generate(e, v.begin(), v.end());
+#else
+    std::generate(v.begin(), v.end(), [&] { return d(e); });
+#endif
+    benchmark::DoNotOptimize(v.data());
+  }
+  st.SetItemsProcessed(st.iterations() * 1024);
+}
+BENCHMARK_CAPTURE(BM_DistributionFill, uniform_int,
+                  std::uniform_int_distribution<>(0, 99));
+BENCHMARK_CAPTURE(BM_DistributionFill, uniform_real,
+                  std::uniform_real_distribution<>(0, 1));
+BENCHMARK_CAPTURE(BM_DistributionFill, normal, std::normal_distribution<>(0, 1));
+
+// binomial_distribution and poisson_distribution change algorithm with the
+// mean, so these take small and large means, with the parameters fixed.
+static void BM_Binomial(benchmark::State& st) {
+  std::mt19937_64 e;
+  std::binomial_distribution<long> d(st.range(0), st.range(1) / 100.);
+  long sum = 0;
+  while (st.KeepRunning()) {
+    for (int i = 0; i < 1024; ++i)
+      sum += d(e);
+  }
+  benchmark::DoNotOptimize(sum);
+  st.SetItemsProcessed(st.iterations() * 1024);
+}
+BENCHMARK(BM_Binomial)->ArgPair(20, 10)->ArgPair(100, 50)->ArgPair(1000, 30)
+    ->ArgPair(1000000, 50);
+
+static void BM_Poisson(benchmark::State& st) {
+  std::mt19937_64 e;
+  std::poisson_distribution<long> d(st.range(0));
+  long sum = 0;
+  while (st.KeepRunning()) {
+    for (int i = 0; i < 1024; ++i)
+      sum += d(e);
+  }
+  benchmark::DoNotOptimize(sum);
+  st.SetItemsProcessed(st.iterations() * 1024);
+}
+BENCHMARK(BM_Poisson)->Arg(1)->Arg(8)->Arg(30)->Arg(1000000);
+
+// Weighted sampling among many outcomes, and among as many intervals.
+static std::vector<double> random_weights(int n) {
+  std::mt19937 e;
+  std::uniform_real_distribution<> d(0.1, 2);
+  std::vector<double> w(n);
+  for (int i = 0; i < n; ++i)
+    w[i] = d(e);
+  return w;
+}
+
+static void BM_Discrete(benchmark::State& st) {
+  std::vector<double> w = random_weights(st.range(0));
+  std::mt19937_64 e;
+  std::discrete_distribution<> d(w.begin(), w.end());
+  long sum = 0;
+  while (st.KeepRunning()) {
+    for (int i = 0; i < 1024; ++i)
+      sum += d(e);
+  }
+  benchmark::DoNotOptimize(sum);
+  st.SetItemsProcessed(st.iterations() * 1024);
+}
+BENCHMARK(BM_Discrete)->Arg(4)->Arg(1000)->Arg(100000)->Arg(1000000);
+
+static void BM_PiecewiseConstant(benchmark::State& st) {
+  std::vector<double> w = random_weights(st.range(0));
+  std::vector<double> b(w.size() + 1);
+  for (size_t i = 0; i < b.size(); ++i)
+    b[i] = i;
+  std::mt19937_64 e;
+  std::piecewise_constant_distribution<> d(b.begin(), b.end(), w.begin());
+  double sum = 0;
+  while (st.KeepRunning()) {
+    for (int i = 0; i < 1024; ++i)
+      sum += d(e);
+  }
+  benchmark::DoNotOptimize(sum);
+  st.SetItemsProcessed(st.iterations() * 1024);
+}
+BENCHMARK(BM_PiecewiseConstant)->Arg(4)->Arg(1000)->Arg(100000);
+
+// Moving far ahead in the sequence, as a parallel job hands each worker its
+// own part of it.
+template <class Engine>
+static void BM_EngineDiscard(benchmark::State& st) {
+  Engine e;
+  while (st.KeepRunning()) {
+    e.discard(st.range(0));
+    benchmark::DoNotOptimize(e);
+  }
+}
+BENCHMARK_TEMPLATE(BM_EngineDiscard, std::mt19937)->Arg(1 << 20);
+
+// The algorithms of <algorithm> that draw on an engine.
+static void BM_Shuffle(benchmark::State& st) {
+  std::vector<int> v(st.range(0));
+  std::iota(v.begin(), v.end(), 0);
+  std::mt19937 e;
+  while (st.KeepRunning()) {
+    std::shuffle(v.begin(), v.end(), e);
+    benchmark::DoNotOptimize(v.data());
+  }
+  st.SetItemsProcessed(st.iterations() * st.range(0));
+}
+BENCHMARK(BM_Shuffle)->Arg(16)->Arg(1 << 10)->Arg(1 << 20);
+
+// The size of the population, then that of the sample.
+static void BM_Sample(benchmark::State& st) {
+  std::vector<int> v(st.range(0));
+  std::iota(v.begin(), v.end(), 0);
+  std::vector<int> out(st.range(1));
+  std::mt19937 e;
+  while (st.KeepRunning()) {
+    std::experimental::sample(v.begin(), v.end(), out.begin(), st.range(1), e);
+    benchmark::DoNotOptimize(out.data());
+  }
+  st.SetItemsProcessed(st.iterations() * st.range(1));
+}
+BENCHMARK(BM_Sample)->ArgPair(1 << 10, 16)->ArgPair(1 << 20, 16)
+    ->ArgPair(1 << 20, 1 << 16);
+
+// The small engines of <experimental/random> are a libc++ extension.
+#ifdef _LIBCPP_VERSION
+namespace ex = std::experimental;
+
+BENCHMARK_TEMPLATE(BM_Engine, ex::splitmix64);
+BENCHMARK_TEMPLATE(BM_Engine, ex::xoshiro256starstar);
+BENCHMARK_TEMPLATE(BM_Engine, ex::pcg32);
+BENCHMARK_TEMPLATE(BM_Engine, ex::philox4x32);
+BENCHMARK_TEMPLATE(BM_Engine, ex::philox4x64);
+
+BENCHMARK_TEMPLATE(BM_EngineDist, ex::xoshiro256starstar, std::uniform_real_distribution<>);
+BENCHMARK_TEMPLATE(BM_EngineDist, ex::pcg32, std::uniform_real_distribution<>);
+BENCHMARK_TEMPLATE(BM_EngineDist, ex::philox4x64, std::uniform_real_distribution<>);
+BENCHMARK_TEMPLATE(BM_EngineDist, ex::xoshiro256starstar, std::normal_distribution<>);
+
+BENCHMARK_TEMPLATE(BM_EngineDiscard, ex::pcg32)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_EngineDiscard, ex::philox4x32)->Arg(1 << 20);
+#endif
+
+BENCHMARK_MAIN()
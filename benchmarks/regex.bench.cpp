@@ -0,0 +1,307 @@
+#include <cstdlib>
+#include <new>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+
+#ifdef _LIBCPP_VERSION
+#include <experimental/regex_set>
+#include <experimental/static_regex>
+#endif
+
+// Every allocation made by the program, to check that matching in a loop
+// does not allocate once it has warmed up.
+static std::size_t allocations = 0;
+
+void* operator new(std::size_t n) {
+  ++allocations;
+  if (void* p = std::malloc(n ? n : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// Log-like text of N bytes with one line of each kind per 16.
+static std::string getText(std::size_t N) {
+  const char* lines[] = {
+      "2017-10-04 12:00:01 INFO Request GET /index.html from 10.0.0.1 "
+      "took 12ms\n",
+      "2017-10-04 12:00:02 WARN Slow request POST /api/v1/items took 950ms\n",
+      "2017-10-04 12:00:03 ERROR Disk /dev/sda1 is full\n"};
+  std::string s;
+  for (std::size_t i = 0; s.size() < N; ++i)
+    s += lines[i % 16 == 15 ? 2 : i % 16 == 7 ? 1 : 0];
+  s.resize(N);
+  return s;
+}
+
+// Reports the allocations made per iteration after the first one.
+static void reportAllocations(benchmark::State& st, std::size_t before) {
+  st.counters["allocs"] =
+      static_cast<double>(allocations - before) / st.iterations();
+}
+
+// Construct the regex.
+static void BM_RegexCompile(benchmark::State& st, const char* pattern,
+                            std::regex_constants::syntax_option_type flags) {
+  while (st.KeepRunning()) {
+    std::regex re(pattern, flags);
+    benchmark::DoNotOptimize(re.mark_count());
+  }
+}
+BENCHMARK_CAPTURE(BM_RegexCompile, literal, "ERROR", std::regex::ECMAScript);
+BENCHMARK_CAPTURE(BM_RegexCompile, fields, "(\\S+) (\\S+) ([A-Z]+) (.*)",
+                  std::regex::ECMAScript);
+BENCHMARK_CAPTURE(BM_RegexCompile, alternation,
+                  "GET|POST|PUT|DELETE|HEAD|OPTIONS", std::regex::ECMAScript);
+BENCHMARK_CAPTURE(BM_RegexCompile, repeat,
+                  "\\d{1,3}\\.\\d{1,3}\\.\\d{1,3}\\.\\d{1,3}",
+                  std::regex::ECMAScript);
+BENCHMARK_CAPTURE(BM_RegexCompile, icase, "[a-z]+ error",
+                  std::regex::ECMAScript | std::regex::icase);
+BENCHMARK_CAPTURE(BM_RegexCompile, classes, "[[:alpha:]][[:alnum:]_]*",
+                  std::regex::extended);
+
+static void BM_RegexSearchAll(benchmark::State& st, const char* pattern,
+                              std::regex_constants::syntax_option_type flags =
+                                  std::regex::ECMAScript) {
+  const std::string s = getText(st.range(0));
+  const std::regex re(pattern, flags);
+  std::smatch m;
+  std::regex_search(s, m, re);
+  std::size_t before = allocations;
+  while (st.KeepRunning()) {
+    std::size_t n = 0;
+    for (std::string::const_iterator i = s.begin();
+         std::regex_search(i, s.end(), m, re); i = m[0].second) {
+      ++n;
+      if (m.length(0) == 0)
+        break;
+    }
+    benchmark::DoNotOptimize(n);
+  }
+  reportAllocations(st, before);
+  st.SetBytesProcessed(st.iterations() * s.size());
+}
+BENCHMARK_CAPTURE(BM_RegexSearchAll, literal, "ERROR")
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK_CAPTURE(BM_RegexSearchAll, class, "[0-9]+ms")
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK_CAPTURE(BM_RegexSearchAll, groups, "(\\w+) (/[\\w/.]+)")
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK_CAPTURE(BM_RegexSearchAll, backref, "(\\d)\\1")
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK_CAPTURE(BM_RegexSearchAll, icase, "error|warn",
+                  std::regex::ECMAScript | std::regex::icase)
+    ->Range(1 << 10, 1 << 20);
+
+// The same search in each grammar, over 1MB.
+BENCHMARK_CAPTURE(BM_RegexSearchAll, ECMAScript, "([0-9]+)ms",
+                  std::regex::ECMAScript)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_RegexSearchAll, basic, "\\([0-9][0-9]*\\)ms",
+                  std::regex::basic)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_RegexSearchAll, extended, "([0-9]+)ms",
+                  std::regex::extended)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_RegexSearchAll, awk, "([0-9]+)ms",
+                  std::regex::awk)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_RegexSearchAll, grep, "\\([0-9][0-9]*\\)ms",
+                  std::regex::grep)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_RegexSearchAll, egrep, "([0-9]+)ms",
+                  std::regex::egrep)->Arg(1 << 20);
+
+static void BM_RegexIterator(benchmark::State& st, const char* pattern) {
+  const std::string s = getText(st.range(0));
+  const std::regex re(pattern);
+  std::size_t before = allocations;
+  while (st.KeepRunning()) {
+    std::size_t n = 0;
+    for (std::sregex_iterator i(s.begin(), s.end(), re), e; i != e; ++i)
+      ++n;
+    benchmark::DoNotOptimize(n);
+  }
+  reportAllocations(st, before);
+  st.SetBytesProcessed(st.iterations() * s.size());
+}
+BENCHMARK_CAPTURE(BM_RegexIterator, words, "[A-Z]+")
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK_CAPTURE(BM_RegexIterator, identifiers, "[a-z0-9_]+")
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK_CAPTURE(BM_RegexIterator, not_space, "\\S+")
+    ->Range(1 << 10, 1 << 20);
+
+// Split the text with a regex_token_iterator, keeping the parts between the
+// matches (-1) or some of the groups.
+static void BM_RegexTokenIterator(benchmark::State& st, const char* pattern,
+                                  std::vector<int> submatches) {
+  const std::string s = getText(st.range(0));
+  const std::regex re(pattern);
+  std::size_t before = allocations;
+  while (st.KeepRunning()) {
+    std::size_t n = 0;
+    for (std::sregex_token_iterator i(s.begin(), s.end(), re, submatches), e;
+         i != e; ++i)
+      n += i->length();
+    benchmark::DoNotOptimize(n);
+  }
+  reportAllocations(st, before);
+  st.SetBytesProcessed(st.iterations() * s.size());
+}
+BENCHMARK_CAPTURE(BM_RegexTokenIterator, split, "[ \\n]+",
+                  std::vector<int>(1, -1))
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK_CAPTURE(BM_RegexTokenIterator, groups, "(\\w+) (/[\\w/.]+)",
+                  std::vector<int>{1, 2})
+    ->Range(1 << 10, 1 << 20);
+
+// Match short strings one after another.
+static void BM_RegexMatchLine(benchmark::State& st, const char* pattern,
+                              std::regex_constants::syntax_option_type flags =
+                                  std::regex::ECMAScript) {
+  const std::string s = getText(1 << 12);
+  std::vector<std::string> lines;
+  for (std::size_t b = 0, e; (e = s.find('\n', b)) != std::string::npos;
+       b = e + 1)
+    lines.push_back(s.substr(b, e - b));
+  const std::regex re(pattern, flags);
+  std::smatch m;
+  for (std::size_t i = 0; i < lines.size(); ++i)
+    std::regex_match(lines[i], m, re);
+  std::size_t before = allocations;
+  while (st.KeepRunning()) {
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < lines.size(); ++i)
+      n += std::regex_match(lines[i], m, re);
+    benchmark::DoNotOptimize(n);
+  }
+  reportAllocations(st, before);
+  st.SetItemsProcessed(st.iterations() * lines.size());
+}
+BENCHMARK_CAPTURE(BM_RegexMatchLine, fields,
+                  "(\\S+) (\\S+) ([A-Z]+) (.*)");
+BENCHMARK_CAPTURE(BM_RegexMatchLine, lookahead,
+                  "(?=.*ERROR)(\\S+) .*");
+BENCHMARK_CAPTURE(BM_RegexMatchLine, anchored,
+                  "^[0-9-]+ [0-9:]+ (INFO|WARN|ERROR) .*ms$");
+BENCHMARK_CAPTURE(BM_RegexMatchLine, date_fields,
+                  "(\\d+)-(\\d+)-(\\d+) ([\\d:]+) ([A-Z]+) (.*)");
+BENCHMARK_CAPTURE(BM_RegexMatchLine, date_fields_extended,
+                  "([0-9]+)-([0-9]+)-([0-9]+) ([0-9:]+) ([A-Z]+) (.*)",
+                  std::regex::extended);
+
+// The compile-time regex is a libc++ extension.
+#ifdef _LIBCPP_VERSION
+constexpr char groupsPattern[] = "(\\w+) (/[\\w/.]+)";
+constexpr char fieldsPattern[] = "(\\S+) (\\S+) ([A-Z]+) (.*)";
+constexpr char dateFieldsPattern[] =
+    "(\\d+)-(\\d+)-(\\d+) ([\\d:]+) ([A-Z]+) (.*)";
+
+// The same as BM_RegexSearchAll with the pattern parsed at compile time.
+template <const char* Pattern>
+static void BM_StaticRegexSearchAll(benchmark::State& st) {
+  const std::string s = getText(st.range(0));
+  const std::experimental::static_regex<Pattern> re;
+  std::smatch m;
+  while (st.KeepRunning()) {
+    std::size_t n = 0;
+    for (std::string::const_iterator i = s.begin();
+         std::experimental::regex_search(i, s.end(), m, re); i = m[0].second) {
+      ++n;
+      if (m.length(0) == 0)
+        break;
+    }
+    benchmark::DoNotOptimize(n);
+  }
+  st.SetBytesProcessed(st.iterations() * s.size());
+}
+BENCHMARK_TEMPLATE(BM_StaticRegexSearchAll, groupsPattern)
+    ->Range(1 << 10, 1 << 20);
+
+// The same as BM_RegexMatchLine with the pattern parsed at compile time.
+template <const char* Pattern>
+static void BM_StaticRegexMatchLine(benchmark::State& st) {
+  const std::string s = getText(1 << 12);
+  std::vector<std::string> lines;
+  for (std::size_t b = 0, e; (e = s.find('\n', b)) != std::string::npos;
+       b = e + 1)
+    lines.push_back(s.substr(b, e - b));
+  const std::experimental::static_regex<Pattern> re;
+  std::smatch m;
+  while (st.KeepRunning()) {
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < lines.size(); ++i)
+      n += std::experimental::regex_match(lines[i], m, re);
+    benchmark::DoNotOptimize(n);
+  }
+  st.SetItemsProcessed(st.iterations() * lines.size());
+}
+BENCHMARK_TEMPLATE(BM_StaticRegexMatchLine, fieldsPattern);
+BENCHMARK_TEMPLATE(BM_StaticRegexMatchLine, dateFieldsPattern);
+#endif
+
+// N routing rules of a few shapes, most of which match no line.
+static std::vector<std::regex> getRules(std::size_t N) {
+  std::vector<std::regex> rules;
+  for (std::size_t i = 0; rules.size() < N; ++i) {
+    std::string n = std::to_string(i);
+    switch (i % 4) {
+    case 0: rules.push_back(std::regex("GET /api/v" + n + "/\\w+")); break;
+    case 1: rules.push_back(std::regex("from 10\\.0\\." + n + "\\.\\d+")); break;
+    case 2: rules.push_back(std::regex("(WARN|ERROR) .*sda" + n)); break;
+    case 3: rules.push_back(std::regex("took " + n + "\\d*ms")); break;
+    }
+  }
+  return rules;
+}
+
+static std::vector<std::string> getLines() {
+  const std::string s = getText(1 << 12);
+  std::vector<std::string> lines;
+  for (std::size_t b = 0, e; (e = s.find('\n', b)) != std::string::npos;
+       b = e + 1)
+    lines.push_back(s.substr(b, e - b));
+  return lines;
+}
+
+// Find the rules that match each line, one rule at a time.
+static void BM_RegexRulesLoop(benchmark::State& st) {
+  const std::vector<std::regex> rules = getRules(st.range(0));
+  const std::vector<std::string> lines = getLines();
+  std::vector<std::size_t> which;
+  while (st.KeepRunning()) {
+    for (std::size_t i = 0; i < lines.size(); ++i) {
+      which.clear();
+      for (std::size_t r = 0; r < rules.size(); ++r)
+        if (std::regex_search(lines[i], rules[r]))
+          which.push_back(r);
+      benchmark::DoNotOptimize(which.data());
+    }
+  }
+  st.SetItemsProcessed(st.iterations() * lines.size());
+}
+BENCHMARK(BM_RegexRulesLoop)->Arg(10)->Arg(100)->Arg(300);
+
+// The regex set is a libc++ experimental extension.
+#ifdef _LIBCPP_VERSION
+// Find the rules that match each line in one pass with a regex set.
+static void BM_RegexRulesSet(benchmark::State& st) {
+  const std::vector<std::regex> rules = getRules(st.range(0));
+  const std::experimental::regex_set set(rules.begin(), rules.end());
+  const std::vector<std::string> lines = getLines();
+  std::vector<std::size_t> which;
+  while (st.KeepRunning()) {
+    for (std::size_t i = 0; i < lines.size(); ++i) {
+      std::experimental::regex_search(lines[i], set, which);
+      benchmark::DoNotOptimize(which.data());
+    }
+  }
+  st.SetItemsProcessed(st.iterations() * lines.size());
+}
+BENCHMARK(BM_RegexRulesSet)->Arg(10)->Arg(100)->Arg(300);
+#endif
+
+BENCHMARK_MAIN()
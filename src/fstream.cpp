@@ -0,0 +1,67 @@
+//===------------------------- fstream.cpp --------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is dual licensed under the MIT and the University of Illinois Open
+// Source Licenses. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "fstream"
+#include "limits"
+
+#if !defined(_LIBCPP_WIN32API)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+
+#if !defined(_LIBCPP_WIN32API) && !defined(_LIBCPP_HAS_NO_GLOBAL_FILESYSTEM_NAMESPACE)
+
+void*
+__libcpp_map_file(FILE* __f, size_t* __len) _NOEXCEPT
+{
+    int __fd = fileno(__f);
+    if (__fd < 0)
+        return nullptr;
+    struct stat __st;
+    if (fstat(__fd, &__st) != 0 || !S_ISREG(__st.st_mode) || __st.st_size <= 0)
+        return nullptr;
+    if (static_cast<unsigned long long>(__st.st_size) >
+        static_cast<unsigned long long>(numeric_limits<streamsize>::max()))
+        return nullptr;
+    size_t __n = static_cast<size_t>(__st.st_size);
+    void* __p = mmap(nullptr, __n, PROT_READ, MAP_PRIVATE, __fd, 0);
+    if (__p == MAP_FAILED)
+        return nullptr;
+#if defined(POSIX_MADV_SEQUENTIAL)
+    posix_madvise(__p, __n, POSIX_MADV_SEQUENTIAL);
+#endif
+    *__len = __n;
+    return __p;
+}
+
+void
+__libcpp_unmap_file(void* __p, size_t __len) _NOEXCEPT
+{
+    munmap(__p, __len);
+}
+
+#else  // _LIBCPP_WIN32API || _LIBCPP_HAS_NO_GLOBAL_FILESYSTEM_NAMESPACE
+
+// Mapping is not supported; basic_filebuf falls back to buffered reads.
+void*
+__libcpp_map_file(FILE*, size_t*) _NOEXCEPT
+{
+    return nullptr;
+}
+
+void
+__libcpp_unmap_file(void*, size_t) _NOEXCEPT
+{
+}
+
+#endif
+
+_LIBCPP_END_NAMESPACE_STD
@@ -121,6 +121,7 @@ const ios_base::openmode ios_base::binary;
 const ios_base::openmode ios_base::in;
 const ios_base::openmode ios_base::out;
 const ios_base::openmode ios_base::trunc;
+const ios_base::openmode ios_base::__mmap;
 
 void
 ios_base::__call_callbacks(event ev)
@@ -141,6 +142,9 @@ ios_base::imbue(const locale& newloc)
     locale& loc_storage = *reinterpret_cast<locale*>(&__loc_);
     locale oldloc = loc_storage;
     loc_storage = newloc;
+#if defined(_LIBCPP_ABI_IOS_FACET_CACHE)
+    _VSTD::fill_n(__facets_, __facet_cache_size, nullptr);
+#endif
     __call_callbacks(imbue_event);
     return oldloc;
 }
@@ -295,6 +299,9 @@ ios_base::init(void* sb)
     __parray_size_ = 0;
     __parray_cap_ = 0;
     ::new(&__loc_) locale;
+#if defined(_LIBCPP_ABI_IOS_FACET_CACHE)
+    _VSTD::fill_n(__facets_, __facet_cache_size, nullptr);
+#endif
 }
 
 void
@@ -347,6 +354,9 @@ ios_base::copyfmt(const ios_base& rhs)
     locale& lhs_loc = *reinterpret_cast<locale*>(&__loc_);
     const locale& rhs_loc = *reinterpret_cast<const locale*>(&rhs.__loc_);
     lhs_loc = rhs_loc;
+#if defined(_LIBCPP_ABI_IOS_FACET_CACHE)
+    _VSTD::copy_n(rhs.__facets_, __facet_cache_size, __facets_);
+#endif
     if (__event_cap_ < rhs.__event_size_)
     {
         free(__fn_);
@@ -390,6 +400,9 @@ ios_base::move(ios_base& rhs)
     __rdbuf_ = 0;
     locale& rhs_loc = *reinterpret_cast<locale*>(&rhs.__loc_);
     ::new(&__loc_) locale(rhs_loc);
+#if defined(_LIBCPP_ABI_IOS_FACET_CACHE)
+    _VSTD::copy_n(rhs.__facets_, __facet_cache_size, __facets_);
+#endif
     __fn_ = rhs.__fn_;
     rhs.__fn_ = 0;
     __index_ = rhs.__index_;
@@ -423,6 +436,9 @@ ios_base::swap(ios_base& rhs) _NOEXCEPT
     locale& lhs_loc = *reinterpret_cast<locale*>(&__loc_);
     locale& rhs_loc = *reinterpret_cast<locale*>(&rhs.__loc_);
     _VSTD::swap(lhs_loc, rhs_loc);
+#if defined(_LIBCPP_ABI_IOS_FACET_CACHE)
+    _VSTD::swap_ranges(__facets_, __facets_ + __facet_cache_size, rhs.__facets_);
+#endif
     _VSTD::swap(__fn_, rhs.__fn_);
     _VSTD::swap(__index_, rhs.__index_);
     _VSTD::swap(__event_size_, rhs.__event_size_);
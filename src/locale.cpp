@@ -36,6 +36,9 @@
 #endif
 #include <stdlib.h>
 #include <stdio.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 #include "include/atomic_support.h"
 #include "__undef_macros"
 
@@ -185,7 +188,14 @@ public:
 
     static const locale& make_classic();
     static       locale& make_global();
+
+    // The classic locale is never destroyed, so references to it are not
+    // counted. Copying the default locale is then free of atomic operations.
+    static void add_ref(__imp* p) {if (p != classic_) p->__add_shared();}
+    static void release_ref(__imp* p) {if (p != classic_) p->__release_shared();}
 private:
+    static __imp* classic_;
+
     void install(facet* f, long id);
     template <class F> void install(F* f) {install(f, f->id.__get());}
     template <class F> void install_from(const __imp& other);
@@ -478,6 +488,8 @@ locale::__imp::use_facet(long id) const
 
 // locale
 
+locale::__imp* locale::__imp::classic_ = nullptr;
+
 const locale&
 locale::__imp::make_classic()
 {
@@ -485,6 +497,7 @@ locale::__imp::make_classic()
     static aligned_storage<sizeof(locale)>::type buf;
     locale* c = reinterpret_cast<locale*>(&buf);
     c->__locale_ = &make<__imp>(1u);
+    classic_ = c->__locale_;
     return *c;
 }
 
@@ -514,25 +527,25 @@ locale::__global()
 locale::locale()  _NOEXCEPT
     : __locale_(__global().__locale_)
 {
-    __locale_->__add_shared();
+    __imp::add_ref(__locale_);
 }
 
 locale::locale(const locale& l)  _NOEXCEPT
     : __locale_(l.__locale_)
 {
-    __locale_->__add_shared();
+    __imp::add_ref(__locale_);
 }
 
 locale::~locale()
 {
-    __locale_->__release_shared();
+    __imp::release_ref(__locale_);
 }
 
 const locale&
 locale::operator=(const locale& other)  _NOEXCEPT
 {
-    other.__locale_->__add_shared();
-    __locale_->__release_shared();
+    __imp::add_ref(other.__locale_);
+    __imp::release_ref(__locale_);
     __locale_ = other.__locale_;
     return *this;
 }
@@ -590,7 +603,7 @@ locale::__install_ctor(const locale& other, facet* f, long id)
         __locale_ = new __imp(*other.__locale_, f, id);
     else
         __locale_ = other.__locale_;
-    __locale_->__add_shared();
+    __imp::add_ref(__locale_);
 }
 
 locale
@@ -914,6 +927,106 @@ ctype<wchar_t>::do_narrow(const char_type* low, const char_type* high, char dfau
 
 // template <> class ctype<char>;
 
+// The classic table maps 'a'-'z' to 'A'-'Z' and back and leaves every other
+// character alone, so ctype<char>'s bulk case conversions can process whole
+// blocks of characters at once instead of looking each one up.  Both return
+// the first character left for the per-character loop.
+
+#if !defined(__SSE2__)
+static const uint64_t ascii_low_bits = 0x0101010101010101ULL;
+#endif
+
+static
+char*
+classic_change_case(char* low, const char* high, char first, char last)
+{
+#if defined(__SSE2__)
+    const __m128i lo = _mm_set1_epi8(static_cast<char>(first - 1));
+    const __m128i hi = _mm_set1_epi8(static_cast<char>(last + 1));
+    const __m128i bit = _mm_set1_epi8(0x20);
+    for (; high - low >= 16; low += 16)
+    {
+        __m128i* p = reinterpret_cast<__m128i*>(low);
+        __m128i v = _mm_loadu_si128(p);
+        // Bytes >= 0x80 compare as negative and are never in [first, last].
+        __m128i in = _mm_and_si128(_mm_cmpgt_epi8(v, lo), _mm_cmplt_epi8(v, hi));
+        _mm_storeu_si128(p, _mm_xor_si128(v, _mm_and_si128(in, bit)));
+    }
+#else
+    // Per byte: with the top bit cleared, adding (0x80 - first) sets it for
+    // bytes >= first and adding (0x7F - last) sets it for bytes > last.
+    const uint64_t ge_first = ascii_low_bits * static_cast<uint64_t>(0x80 - first);
+    const uint64_t gt_last = ascii_low_bits * static_cast<uint64_t>(0x7F - last);
+    for (; high - low >= 8; low += 8)
+    {
+        uint64_t w;
+        memcpy(&w, low, sizeof(w));
+        uint64_t b = w & ~(ascii_low_bits * 0x80);
+        uint64_t in = ((b + ge_first) ^ (b + gt_last)) & ~w & (ascii_low_bits * 0x80);
+        w ^= in >> 2;
+        memcpy(low, &w, sizeof(w));
+    }
+#endif
+    return low;
+}
+
+#if defined(__SSE2__) && !defined(_LIBCPP_CTYPE_MASK_IS_COMPOSITE_PRINT) \
+                      && !defined(_LIBCPP_CTYPE_MASK_IS_COMPOSITE_ALPHA) \
+                      && !defined(_LIBCPP_CTYPE_MASK_IS_COMPOSITE_XDIGIT)
+#define _LIBCPP_CLASSIC_SCAN_BLOCKS
+
+static inline
+__m128i
+classic_in_range(__m128i v, char first, char last)
+{
+    return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(static_cast<char>(first - 1))),
+                         _mm_cmplt_epi8(v, _mm_set1_epi8(static_cast<char>(last + 1))));
+}
+
+static inline
+__m128i
+classic_equal(__m128i v, char c)
+{
+    return _mm_cmpeq_epi8(v, _mm_set1_epi8(c));
+}
+
+// Where each classification bit is a distinct flag, a character matches a
+// mask in the classic table exactly when it falls in one of the "C" locale
+// ranges of the classes named in the mask.  Returns 0xFF in each matching
+// byte.
+static
+__m128i
+classic_match(__m128i v, ctype_base::mask m)
+{
+    __m128i r = _mm_setzero_si128();
+    if (m & (ctype_base::upper | ctype_base::alpha))
+        r = _mm_or_si128(r, classic_in_range(v, 'A', 'Z'));
+    if (m & (ctype_base::lower | ctype_base::alpha))
+        r = _mm_or_si128(r, classic_in_range(v, 'a', 'z'));
+    if (m & (ctype_base::digit | ctype_base::xdigit))
+        r = _mm_or_si128(r, classic_in_range(v, '0', '9'));
+    if (m & ctype_base::xdigit)
+        r = _mm_or_si128(r, _mm_or_si128(classic_in_range(v, 'A', 'F'),
+                                         classic_in_range(v, 'a', 'f')));
+    if (m & ctype_base::space)
+        r = _mm_or_si128(r, _mm_or_si128(classic_in_range(v, '\t', '\r'),
+                                         classic_equal(v, ' ')));
+    if (m & ctype_base::blank)
+        r = _mm_or_si128(r, _mm_or_si128(classic_equal(v, '\t'),
+                                         classic_equal(v, ' ')));
+    if (m & ctype_base::print)
+        r = _mm_or_si128(r, classic_in_range(v, ' ', '~'));
+    if (m & ctype_base::cntrl)
+        r = _mm_or_si128(r, _mm_or_si128(classic_in_range(v, '\0', '\x1F'),
+                                         classic_equal(v, '\x7F')));
+    if (m & ctype_base::punct)
+        r = _mm_or_si128(r, _mm_or_si128(
+                _mm_or_si128(classic_in_range(v, '!', '/'), classic_in_range(v, ':', '@')),
+                _mm_or_si128(classic_in_range(v, '[', '`'), classic_in_range(v, '{', '~'))));
+    return r;
+}
+#endif  // __SSE2__ && !_LIBCPP_CTYPE_MASK_IS_COMPOSITE_*
+
 locale::id ctype<char>::id;
 
 ctype<char>::ctype(const mask* tab, bool del, size_t refs)
@@ -950,6 +1063,7 @@ ctype<char>::do_toupper(char_type c) const
 const char*
 ctype<char>::do_toupper(char_type* low, const char_type* high) const
 {
+    low = classic_change_case(low, high, 'a', 'z');
     for (; low != high; ++low)
 #ifdef _LIBCPP_HAS_DEFAULTRUNELOCALE
         *low = isascii(*low) ?
@@ -984,6 +1098,7 @@ ctype<char>::do_tolower(char_type c) const
 const char*
 ctype<char>::do_tolower(char_type* low, const char_type* high) const
 {
+    low = classic_change_case(low, high, 'A', 'Z');
     for (; low != high; ++low)
 #ifdef _LIBCPP_HAS_DEFAULTRUNELOCALE
         *low = isascii(*low) ? static_cast<char>(_DefaultRuneLocale.__maplower[static_cast<ptrdiff_t>(*low)]) : *low;
@@ -997,6 +1112,31 @@ ctype<char>::do_tolower(char_type* low, const char_type* high) const
     return low;
 }
 
+const char*
+ctype<char>::__scan(mask m, const char_type* low, const char_type* high, bool is) const
+{
+#ifdef _LIBCPP_CLASSIC_SCAN_BLOCKS
+    const mask classes = space | print | cntrl | upper | lower | alpha |
+                         digit | punct | xdigit | blank;
+    if (high - low >= 16 && (m & ~classes) == 0 && __tab_ == classic_table())
+    {
+        for (; high - low >= 16; low += 16)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(low));
+            int found = _mm_movemask_epi8(classic_match(v, m));
+            if (!is)
+                found ^= 0xFFFF;
+            if (found)
+                return low + __ctz(static_cast<unsigned>(found));
+        }
+    }
+#endif
+    for (; low != high; ++low)
+        if ((isascii(*low) && (__tab_[static_cast<int>(*low)] & m)) == is)
+            break;
+    return low;
+}
+
 char
 ctype<char>::do_widen(char c) const
 {
@@ -1732,6 +1872,168 @@ codecvt<wchar_t, char, mbstate_t>::do_max_length() const  _NOEXCEPT
 // 040000 - 0FFFFF  D8C0 - DBBF, DC00 - DFFF  F1 - F3, 80 - BF, 80 - BF, 80 - BF   786432
 // 100000 - 10FFFF  DBC0 - DBFF, DC00 - DFFF  F4 - F4, 80 - 8F, 80 - BF, 80 - BF    65536
 
+// ASCII fast paths for the UTF-8 transcoders below.  Once a transcoder has
+// handled an ASCII code unit and sees another one, it hands the rest of the
+// run to one of these, which convert the longest prefix of code units < 0x80
+// that fits in both ranges and return its length.  The first few units are
+// done one at a time so that the short runs typical of non-Latin text stay
+// cheap; longer runs go 16 units at a time with SSE2, or 8 at a time with a
+// word-wide test otherwise.  Everything else stays on the per-code-point path,
+// and the helpers are kept out of line so that path is compiled as before.
+
+#if defined(_LIBCPP_COMPILER_MSVC)
+#define _LIBCPP_ASCII_NOINLINE __declspec(noinline)
+#else
+#define _LIBCPP_ASCII_NOINLINE __attribute__((__noinline__))
+#endif
+
+#if !defined(__SSE2__)
+static const uint64_t ascii_high_bits = 0x8080808080808080ULL;
+#endif
+
+static _LIBCPP_ASCII_NOINLINE
+size_t
+utf8_ascii_prefix(const uint8_t* frm, size_t n)
+{
+    size_t i = 0;
+    for (; i < n && i < 8; ++i)
+        if (frm[i] >= 0x80)
+            return i;
+#if defined(__SSE2__)
+    for (; n - i >= 16; i += 16)
+        if (_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(frm + i))))
+            break;
+#else
+    for (; n - i >= 8; i += 8)
+    {
+        uint64_t w;
+        memcpy(&w, frm + i, sizeof(w));
+        if (w & ascii_high_bits)
+            break;
+    }
+#endif
+    while (i < n && frm[i] < 0x80)
+        ++i;
+    return i;
+}
+
+template <class _Up>
+static _LIBCPP_ASCII_NOINLINE
+size_t
+utf8_ascii_widen(const uint8_t* frm, const uint8_t* frm_end, _Up* to, _Up* to_end)
+{
+    size_t n = static_cast<size_t>(min(frm_end - frm, to_end - to));
+    size_t i = 0;
+    for (; i < n && i < 8; ++i)
+    {
+        if (frm[i] >= 0x80)
+            return i;
+        to[i] = static_cast<_Up>(frm[i]);
+    }
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    for (; n - i >= 16; i += 16)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(frm + i));
+        if (_mm_movemask_epi8(v))
+            break;
+        __m128i lo = _mm_unpacklo_epi8(v, zero);
+        __m128i hi = _mm_unpackhi_epi8(v, zero);
+        __m128i* out = reinterpret_cast<__m128i*>(to + i);
+        if (sizeof(_Up) == 2)
+        {
+            _mm_storeu_si128(out, lo);
+            _mm_storeu_si128(out + 1, hi);
+        }
+        else
+        {
+            _mm_storeu_si128(out,     _mm_unpacklo_epi16(lo, zero));
+            _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(lo, zero));
+            _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(hi, zero));
+            _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(hi, zero));
+        }
+    }
+#else
+    for (; n - i >= 8; i += 8)
+    {
+        uint64_t w;
+        memcpy(&w, frm + i, sizeof(w));
+        if (w & ascii_high_bits)
+            break;
+        for (size_t j = 0; j < 8; ++j)
+            to[i + j] = static_cast<_Up>(frm[i + j]);
+    }
+#endif
+    for (; i < n && frm[i] < 0x80; ++i)
+        to[i] = static_cast<_Up>(frm[i]);
+    return i;
+}
+
+static _LIBCPP_ASCII_NOINLINE
+size_t
+utf8_ascii_narrow(const uint16_t* frm, const uint16_t* frm_end, uint8_t* to, uint8_t* to_end)
+{
+    size_t n = static_cast<size_t>(min(frm_end - frm, to_end - to));
+    size_t i = 0;
+    for (; i < n && i < 8; ++i)
+    {
+        if (frm[i] >= 0x80)
+            return i;
+        to[i] = static_cast<uint8_t>(frm[i]);
+    }
+#if defined(__SSE2__)
+    const __m128i mask = _mm_set1_epi16(static_cast<short>(0xFF80));
+    const __m128i zero = _mm_setzero_si128();
+    for (; n - i >= 16; i += 16)
+    {
+        const __m128i* in = reinterpret_cast<const __m128i*>(frm + i);
+        __m128i a = _mm_loadu_si128(in);
+        __m128i b = _mm_loadu_si128(in + 1);
+        __m128i t = _mm_and_si128(_mm_or_si128(a, b), mask);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(t, zero)) != 0xFFFF)
+            break;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(to + i), _mm_packus_epi16(a, b));
+    }
+#endif
+    for (; i < n && frm[i] < 0x80; ++i)
+        to[i] = static_cast<uint8_t>(frm[i]);
+    return i;
+}
+
+static _LIBCPP_ASCII_NOINLINE
+size_t
+utf8_ascii_narrow(const uint32_t* frm, const uint32_t* frm_end, uint8_t* to, uint8_t* to_end)
+{
+    size_t n = static_cast<size_t>(min(frm_end - frm, to_end - to));
+    size_t i = 0;
+    for (; i < n && i < 8; ++i)
+    {
+        if (frm[i] >= 0x80)
+            return i;
+        to[i] = static_cast<uint8_t>(frm[i]);
+    }
+#if defined(__SSE2__)
+    const __m128i mask = _mm_set1_epi32(static_cast<int>(0xFFFFFF80));
+    const __m128i zero = _mm_setzero_si128();
+    for (; n - i >= 16; i += 16)
+    {
+        const __m128i* in = reinterpret_cast<const __m128i*>(frm + i);
+        __m128i a = _mm_loadu_si128(in);
+        __m128i b = _mm_loadu_si128(in + 1);
+        __m128i c = _mm_loadu_si128(in + 2);
+        __m128i d = _mm_loadu_si128(in + 3);
+        __m128i t = _mm_and_si128(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d)), mask);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(t, zero)) != 0xFFFF)
+            break;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(to + i),
+                         _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+    }
+#endif
+    for (; i < n && frm[i] < 0x80; ++i)
+        to[i] = static_cast<uint8_t>(frm[i]);
+    return i;
+}
+
 static
 codecvt_base::result
 utf16_to_utf8(const uint16_t* frm, const uint16_t* frm_end, const uint16_t*& frm_nxt,
@@ -1758,6 +2060,12 @@ utf16_to_utf8(const uint16_t* frm, const uint16_t* frm_end, const uint16_t*& frm
             if (to_end-to_nxt < 1)
                 return codecvt_base::partial;
             *to_nxt++ = static_cast<uint8_t>(wc1);
+            if (Maxcode >= 0x7F && frm_end-frm_nxt > 1 && frm_nxt[1] < 0x80)
+            {
+                size_t n = utf8_ascii_narrow(frm_nxt + 1, frm_end, to_nxt, to_end);
+                frm_nxt += n;
+                to_nxt += n;
+            }
         }
         else if (wc1 < 0x0800)
         {
@@ -1835,6 +2143,12 @@ utf16_to_utf8(const uint32_t* frm, const uint32_t* frm_end, const uint32_t*& frm
             if (to_end-to_nxt < 1)
                 return codecvt_base::partial;
             *to_nxt++ = static_cast<uint8_t>(wc1);
+            if (Maxcode >= 0x7F && frm_end-frm_nxt > 1 && frm_nxt[1] < 0x80)
+            {
+                size_t n = utf8_ascii_narrow(frm_nxt + 1, frm_end, to_nxt, to_end);
+                frm_nxt += n;
+                to_nxt += n;
+            }
         }
         else if (wc1 < 0x0800)
         {
@@ -1909,6 +2223,12 @@ utf8_to_utf16(const uint8_t* frm, const uint8_t* frm_end, const uint8_t*& frm_nx
         {
             *to_nxt = static_cast<uint16_t>(c1);
             ++frm_nxt;
+            if (Maxcode >= 0x7F && frm_nxt < frm_end && *frm_nxt < 0x80)
+            {
+                size_t n = utf8_ascii_widen(frm_nxt, frm_end, to_nxt + 1, to_end);
+                frm_nxt += n;
+                to_nxt += n;
+            }
         }
         else if (c1 < 0xC2)
         {
@@ -2030,6 +2350,12 @@ utf8_to_utf16(const uint8_t* frm, const uint8_t* frm_end, const uint8_t*& frm_nx
         {
             *to_nxt = static_cast<uint32_t>(c1);
             ++frm_nxt;
+            if (Maxcode >= 0x7F && frm_nxt < frm_end && *frm_nxt < 0x80)
+            {
+                size_t n = utf8_ascii_widen(frm_nxt, frm_end, to_nxt + 1, to_end);
+                frm_nxt += n;
+                to_nxt += n;
+            }
         }
         else if (c1 < 0xC2)
         {
@@ -2149,6 +2475,13 @@ utf8_to_utf16_length(const uint8_t* frm, const uint8_t* frm_end,
         if (c1 < 0x80)
         {
             ++frm_nxt;
+            if (Maxcode >= 0x7F && frm_nxt < frm_end && *frm_nxt < 0x80)
+            {
+                size_t n = utf8_ascii_prefix(frm_nxt,
+                               min(static_cast<size_t>(frm_end - frm_nxt), mx - nchar16_t - 1));
+                frm_nxt += n;
+                nchar16_t += n;
+            }
         }
         else if (c1 < 0xC2)
         {
@@ -2255,6 +2588,12 @@ ucs4_to_utf8(const uint32_t* frm, const uint32_t* frm_end, const uint32_t*& frm_
             if (to_end-to_nxt < 1)
                 return codecvt_base::partial;
             *to_nxt++ = static_cast<uint8_t>(wc);
+            if (Maxcode >= 0x7F && frm_end-frm_nxt > 1 && frm_nxt[1] < 0x80)
+            {
+                size_t n = utf8_ascii_narrow(frm_nxt + 1, frm_end, to_nxt, to_end);
+                frm_nxt += n;
+                to_nxt += n;
+            }
         }
         else if (wc < 0x000800)
         {
@@ -2307,6 +2646,12 @@ utf8_to_ucs4(const uint8_t* frm, const uint8_t* frm_end, const uint8_t*& frm_nxt
                 return codecvt_base::error;
             *to_nxt = static_cast<uint32_t>(c1);
             ++frm_nxt;
+            if (Maxcode >= 0x7F && frm_nxt < frm_end && *frm_nxt < 0x80)
+            {
+                size_t n = utf8_ascii_widen(frm_nxt, frm_end, to_nxt + 1, to_end);
+                frm_nxt += n;
+                to_nxt += n;
+            }
         }
         else if (c1 < 0xC2)
         {
@@ -2419,6 +2764,13 @@ utf8_to_ucs4_length(const uint8_t* frm, const uint8_t* frm_end,
             if (c1 > Maxcode)
                 break;
             ++frm_nxt;
+            if (Maxcode >= 0x7F && frm_nxt < frm_end && *frm_nxt < 0x80)
+            {
+                size_t n = utf8_ascii_prefix(frm_nxt,
+                               min(static_cast<size_t>(frm_end - frm_nxt), mx - nchar32_t - 1));
+                frm_nxt += n;
+                nchar32_t += n;
+            }
         }
         else if (c1 < 0xC2)
         {
@@ -2522,6 +2874,12 @@ ucs2_to_utf8(const uint16_t* frm, const uint16_t* frm_end, const uint16_t*& frm_
             if (to_end-to_nxt < 1)
                 return codecvt_base::partial;
             *to_nxt++ = static_cast<uint8_t>(wc);
+            if (Maxcode >= 0x7F && frm_end-frm_nxt > 1 && frm_nxt[1] < 0x80)
+            {
+                size_t n = utf8_ascii_narrow(frm_nxt + 1, frm_end, to_nxt, to_end);
+                frm_nxt += n;
+                to_nxt += n;
+            }
         }
         else if (wc < 0x0800)
         {
@@ -2565,6 +2923,12 @@ utf8_to_ucs2(const uint8_t* frm, const uint8_t* frm_end, const uint8_t*& frm_nxt
                 return codecvt_base::error;
             *to_nxt = static_cast<uint16_t>(c1);
             ++frm_nxt;
+            if (Maxcode >= 0x7F && frm_nxt < frm_end && *frm_nxt < 0x80)
+            {
+                size_t n = utf8_ascii_widen(frm_nxt, frm_end, to_nxt + 1, to_end);
+                frm_nxt += n;
+                to_nxt += n;
+            }
         }
         else if (c1 < 0xC2)
         {
@@ -2644,6 +3008,13 @@ utf8_to_ucs2_length(const uint8_t* frm, const uint8_t* frm_end,
             if (c1 > Maxcode)
                 break;
             ++frm_nxt;
+            if (Maxcode >= 0x7F && frm_nxt < frm_end && *frm_nxt < 0x80)
+            {
+                size_t n = utf8_ascii_prefix(frm_nxt,
+                               min(static_cast<size_t>(frm_end - frm_nxt), mx - nchar32_t - 1));
+                frm_nxt += n;
+                nchar32_t += n;
+            }
         }
         else if (c1 < 0xC2)
         {
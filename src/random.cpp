@@ -30,6 +30,19 @@
 #elif defined(_LIBCPP_USING_DEV_RANDOM)
 #include <fcntl.h>
 #include <unistd.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#if defined(SYS_getrandom)
+#define _LIBCPP_USING_GETRANDOM
+#ifndef GRND_NONBLOCK
+#define GRND_NONBLOCK 0x0001
+#endif
+#if defined(_LIBCPP_HAS_THREAD_API_PTHREAD)
+#include <pthread.h>
+#include "__threading_support"
+#endif
+#endif
+#endif
 #elif defined(_LIBCPP_USING_NACL_RANDOM)
 #include <nacl/nacl_random.h>
 #endif
@@ -60,6 +73,22 @@ random_device::operator()()
     return r;
 }
 
+void
+random_device::__fill(unsigned* __first, unsigned* __last)
+{
+    char* p = reinterpret_cast<char*>(__first);
+    size_t n = static_cast<size_t>(__last - __first) * sizeof(unsigned);
+    while (n > 0)
+    {
+        // getentropy gives at most 256 bytes at a time.
+        size_t k = n < 256 ? n : 256;
+        if (getentropy(p, k))
+            __throw_system_error(errno, "random_device getentropy failed");
+        n -= k;
+        p += k;
+    }
+}
+
 #elif defined(_LIBCPP_USING_ARC4_RANDOM)
 
 random_device::random_device(const string& __token)
@@ -78,43 +107,241 @@ random_device::operator()()
     return arc4random();
 }
 
+void
+random_device::__fill(unsigned* __first, unsigned* __last)
+{
+    arc4random_buf(__first, static_cast<size_t>(__last - __first) * sizeof(unsigned));
+}
+
 #elif defined(_LIBCPP_USING_DEV_RANDOM)
 
+namespace
+{
+
+void
+__read_bytes(int __f, char* p, size_t n)
+{
+    while (n > 0)
+    {
+        ssize_t s = read(__f, p, n);
+        if (s == 0)
+            __throw_system_error(ENODATA, "random_device got EOF");
+        if (s == -1)
+        {
+            if (errno != EINTR)
+                __throw_system_error(errno, "random_device got an unexpected error");
+            continue;
+        }
+        n -= static_cast<size_t>(s);
+        p += static_cast<size_t>(s);
+    }
+}
+
+#if defined(_LIBCPP_USING_GETRANDOM)
+
+// The default device reads from the getrandom system call, which needs no
+// file descriptor, into a buffer kept per thread, so that operator() makes
+// a system call only once in 64 values.  The child of a fork throws away
+// what is left in the buffer, so that it does not give the values its
+// parent gives.  Without pthreads there is no fork handler, and no buffer.
+//
+// getrandom is called with GRND_NONBLOCK: like /dev/urandom, the device does
+// not wait for the kernel's pool to be initialized early in boot, and reads
+// /dev/urandom until it is.
+
+struct __close_on_exit
+{
+    int __f_;
+    ~__close_on_exit() {close(__f_);}
+};
+
+void
+__urandom_bytes(char* p, size_t n)
+{
+    int __f = open("/dev/urandom", O_RDONLY);
+    if (__f < 0)
+        __throw_system_error(errno, "random_device failed to open /dev/urandom");
+    __close_on_exit __c = {__f};
+    __read_bytes(__c.__f_, p, n);
+}
+
+void
+__getrandom_bytes(char* p, size_t n)
+{
+    while (n > 0)
+    {
+        long s = syscall(SYS_getrandom, p, n, GRND_NONBLOCK);
+        if (s == -1)
+        {
+            if (errno == EAGAIN)
+            {
+                __urandom_bytes(p, n);
+                return;
+            }
+            if (errno != EINTR)
+                __throw_system_error(errno, "random_device getrandom failed");
+            continue;
+        }
+        n -= static_cast<size_t>(s);
+        p += static_cast<size_t>(s);
+    }
+}
+
+bool
+__getrandom_works()
+{
+    static const bool __b =
+        syscall(SYS_getrandom, nullptr, 0, GRND_NONBLOCK) == 0 || errno == EAGAIN;
+    return __b;
+}
+
+struct __random_buffer
+{
+    static const unsigned __size = 64;
+    unsigned __v_[__size];
+    unsigned __n_;
+
+    __random_buffer() : __n_(0) {}
+    ~__random_buffer()
+    {
+        for (unsigned __i = 0; __i < __n_; ++__i)
+            __v_[__i] = 0;
+    }
+};
+
+#if defined(_LIBCPP_HAS_THREAD_API_PTHREAD)
+
+void _LIBCPP_TLS_DESTRUCTOR_CC
+__delete_random_buffer(void* __p)
+{
+    delete static_cast<__random_buffer*>(__p);
+}
+
+__libcpp_tls_key __random_buffer_key;
+
+void
+__clear_random_buffer()
+{
+    __random_buffer* __b =
+        static_cast<__random_buffer*>(__libcpp_tls_get(__random_buffer_key));
+    if (__b != nullptr)
+        __b->__n_ = 0;
+}
+
+bool
+__create_random_buffer_key()
+{
+    return __libcpp_tls_create(&__random_buffer_key, &__delete_random_buffer) == 0 &&
+           pthread_atfork(nullptr, nullptr, &__clear_random_buffer) == 0;
+}
+
+// The buffer of the calling thread, or null if it can not have one.
+__random_buffer*
+__thread_random_buffer()
+{
+    static const bool __valid = __create_random_buffer_key();
+    if (!__valid)
+        return nullptr;
+    __random_buffer* __b =
+        static_cast<__random_buffer*>(__libcpp_tls_get(__random_buffer_key));
+    if (__b == nullptr)
+    {
+#ifndef _LIBCPP_NO_EXCEPTIONS
+        try
+        {
+#endif  // _LIBCPP_NO_EXCEPTIONS
+            __b = new __random_buffer;
+#ifndef _LIBCPP_NO_EXCEPTIONS
+        }
+        catch (...)
+        {
+            return nullptr;
+        }
+#endif  // _LIBCPP_NO_EXCEPTIONS
+        if (__libcpp_tls_set(__random_buffer_key, __b) != 0)
+        {
+            delete __b;
+            return nullptr;
+        }
+    }
+    return __b;
+}
+
+#else  // _LIBCPP_HAS_THREAD_API_PTHREAD
+
+__random_buffer*
+__thread_random_buffer()
+{
+    return nullptr;
+}
+
+#endif  // _LIBCPP_HAS_THREAD_API_PTHREAD
+
+#endif  // _LIBCPP_USING_GETRANDOM
+
+}  // unnamed namespace
+
+// __f_ is -1 for the default device when it reads from getrandom.
 random_device::random_device(const string& __token)
-    : __f_(open(__token.c_str(), O_RDONLY))
+    : __f_(-1)
 {
+#if defined(_LIBCPP_USING_GETRANDOM)
+    if (__token == "/dev/urandom" && __getrandom_works())
+        return;
+#endif
+    __f_ = open(__token.c_str(), O_RDONLY);
     if (__f_ < 0)
         __throw_system_error(errno, ("random_device failed to open " + __token).c_str());
 }
 
 random_device::~random_device()
 {
-    close(__f_);
+    if (__f_ >= 0)
+        close(__f_);
 }
 
 unsigned
 random_device::operator()()
 {
     unsigned r;
-    size_t n = sizeof(r);
-    char* p = reinterpret_cast<char*>(&r);
-    while (n > 0)
+#if defined(_LIBCPP_USING_GETRANDOM)
+    if (__f_ < 0)
     {
-        ssize_t s = read(__f_, p, n);
-        if (s == 0)
-            __throw_system_error(ENODATA, "random_device got EOF");
-        if (s == -1)
+        if (__random_buffer* __b = __thread_random_buffer())
         {
-            if (errno != EINTR)
-                __throw_system_error(errno, "random_device got an unexpected error");
-            continue;
+            if (__b->__n_ == 0)
+            {
+                __getrandom_bytes(reinterpret_cast<char*>(__b->__v_), sizeof(__b->__v_));
+                __b->__n_ = __random_buffer::__size;
+            }
+            // Values are not kept once given out.
+            r = __b->__v_[--__b->__n_];
+            __b->__v_[__b->__n_] = 0;
+            return r;
         }
-        n -= static_cast<size_t>(s);
-        p += static_cast<size_t>(s);
+        __getrandom_bytes(reinterpret_cast<char*>(&r), sizeof(r));
+        return r;
     }
+#endif
+    __read_bytes(__f_, reinterpret_cast<char*>(&r), sizeof(r));
     return r;
 }
 
+void
+random_device::__fill(unsigned* __first, unsigned* __last)
+{
+    char* p = reinterpret_cast<char*>(__first);
+    size_t n = static_cast<size_t>(__last - __first) * sizeof(unsigned);
+#if defined(_LIBCPP_USING_GETRANDOM)
+    if (__f_ < 0)
+    {
+        __getrandom_bytes(p, n);
+        return;
+    }
+#endif
+    __read_bytes(__f_, p, n);
+}
+
 #elif defined(_LIBCPP_USING_NACL_RANDOM)
 
 random_device::random_device(const string& __token)
@@ -144,6 +371,18 @@ random_device::operator()()
     return r;
 }
 
+void
+random_device::__fill(unsigned* __first, unsigned* __last)
+{
+    size_t n = static_cast<size_t>(__last - __first) * sizeof(unsigned);
+    size_t bytes_written;
+    int error = nacl_secure_random(__first, n, &bytes_written);
+    if (error != 0)
+        __throw_system_error(error, "random_device failed getting bytes");
+    else if (bytes_written != n)
+        __throw_runtime_error("random_device failed to obtain enough bytes");
+}
+
 #elif defined(_LIBCPP_USING_WIN32_RANDOM)
 
 random_device::random_device(const string& __token)
@@ -166,6 +405,13 @@ random_device::operator()()
     return r;
 }
 
+void
+random_device::__fill(unsigned* __first, unsigned* __last)
+{
+    for (; __first != __last; ++__first)
+        *__first = operator()();
+}
+
 #else
 #error "Random device not implemented for this architecture"
 #endif
@@ -10,6 +10,12 @@
 #include "regex"
 #include "algorithm"
 #include "iterator"
+#ifndef _LIBCPP_HAS_NO_THREADS
+#include "__threading_support"
+#endif
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 _LIBCPP_BEGIN_NAMESPACE_STD
 
@@ -312,4 +318,135 @@ __match_any_but_newline<wchar_t>::__exec(__state& __s) const
     }
 }
 
+namespace
+{
+
+// The regex caches of one thread: one per character type for searches, and
+// one per character type for the lookaheads they run.
+struct __regex_thread_caches
+{
+    static const unsigned __size = 4;
+    __regex_cache_base* __slot_[__size];
+
+    __regex_thread_caches()
+    {
+        for (unsigned __i = 0; __i < __size; ++__i)
+            __slot_[__i] = nullptr;
+    }
+    ~__regex_thread_caches()
+    {
+        for (unsigned __i = 0; __i < __size; ++__i)
+            delete __slot_[__i];
+    }
+};
+
+#ifndef _LIBCPP_HAS_NO_THREADS
+
+void _LIBCPP_TLS_DESTRUCTOR_CC
+__delete_regex_thread_caches(void* __p)
+{
+    delete static_cast<__regex_thread_caches*>(__p);
+}
+
+struct __regex_thread_key
+{
+    __libcpp_tls_key __key_;
+    bool __valid_;
+
+    __regex_thread_key()
+        : __valid_(__libcpp_tls_create(&__key_,
+                                       &__delete_regex_thread_caches) == 0) {}
+};
+
+#endif  // _LIBCPP_HAS_NO_THREADS
+
+}  // unnamed namespace
+
+__regex_cache_base**
+__regex_thread_cache(unsigned __slot)
+{
+    if (__slot >= __regex_thread_caches::__size)
+        return nullptr;
+#ifndef _LIBCPP_HAS_NO_THREADS
+    static __regex_thread_key __k;
+    if (!__k.__valid_)
+        return nullptr;
+    __regex_thread_caches* __c =
+        static_cast<__regex_thread_caches*>(__libcpp_tls_get(__k.__key_));
+    if (__c == nullptr)
+    {
+#ifndef _LIBCPP_NO_EXCEPTIONS
+        try
+        {
+#endif  // _LIBCPP_NO_EXCEPTIONS
+            __c = new __regex_thread_caches;
+#ifndef _LIBCPP_NO_EXCEPTIONS
+        }
+        catch (...)
+        {
+            return nullptr;
+        }
+#endif  // _LIBCPP_NO_EXCEPTIONS
+        if (__libcpp_tls_set(__k.__key_, __c) != 0)
+        {
+            delete __c;
+            return nullptr;
+        }
+    }
+#else  // _LIBCPP_HAS_NO_THREADS
+    static __regex_thread_caches __caches;
+    __regex_thread_caches* __c = &__caches;
+#endif  // _LIBCPP_HAS_NO_THREADS
+    return &__c->__slot_[__slot];
+}
+
+static inline
+bool
+__in_ranges(const unsigned char* __ranges, unsigned __n, unsigned char __c)
+{
+    for (unsigned __i = 0; __i < __n; ++__i)
+        if (__ranges[2 * __i] <= __c && __c <= __ranges[2 * __i + 1])
+            return true;
+    return false;
+}
+
+const char*
+__regex_span(const unsigned char* __ranges, unsigned __n, const char* __first,
+             const char* __last, bool __in)
+{
+#if defined(__SSE2__)
+    __m128i __lo[4];
+    __m128i __width[4];
+    if (__n <= 4)
+    {
+        for (unsigned __i = 0; __i < __n; ++__i)
+        {
+            __lo[__i] = _mm_set1_epi8(static_cast<char>(__ranges[2 * __i]));
+            __width[__i] = _mm_set1_epi8(static_cast<char>(
+                __ranges[2 * __i + 1] - __ranges[2 * __i]));
+        }
+        for (; __last - __first >= 16; __first += 16)
+        {
+            __m128i __v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(__first));
+            __m128i __r = _mm_setzero_si128();
+            // A byte is in [lo, lo + width] when it is at most width above lo.
+            for (unsigned __i = 0; __i < __n; ++__i)
+            {
+                __m128i __d = _mm_sub_epi8(__v, __lo[__i]);
+                __r = _mm_or_si128(__r, _mm_cmpeq_epi8(_mm_min_epu8(__d, __width[__i]), __d));
+            }
+            int __found = _mm_movemask_epi8(__r);
+            if (__in)
+                __found ^= 0xFFFF;
+            if (__found)
+                return __first + __ctz(static_cast<unsigned>(__found));
+        }
+    }
+#endif
+    for (; __first != __last; ++__first)
+        if (__in_ranges(__ranges, __n, static_cast<unsigned char>(*__first)) != __in)
+            break;
+    return __first;
+}
+
 _LIBCPP_END_NAMESPACE_STD
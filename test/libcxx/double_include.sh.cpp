@@ -152,9 +152,12 @@
 #include <experimental/numeric>
 #include <experimental/optional>
 #include <experimental/propagate_const>
+#include <experimental/random>
 #include <experimental/ratio>
 #include <experimental/regex>
+#include <experimental/regex_set>
 #include <experimental/set>
+#include <experimental/static_regex>
 #include <experimental/string>
 #include <experimental/string_view>
 #include <experimental/system_error>
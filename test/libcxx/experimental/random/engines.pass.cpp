@@ -0,0 +1,172 @@
+//===----------------------------------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is dual licensed under the MIT and the University of Illinois Open
+// Source Licenses. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++98, c++03
+
+// <experimental/random>
+
+// splitmix64, xoshiro256starstar, pcg32, philox4x32 and philox4x64 give the
+// values of the reference implementations, meet the requirements of a random
+// number engine, and discard as many values as the same number of calls.
+
+#include <experimental/random>
+#include <sstream>
+#include <cassert>
+
+namespace ex = std::experimental;
+
+template <class Engine>
+void test_engine()
+{
+    typedef typename Engine::result_type result_type;
+    static_assert(Engine::min() == 0, "");
+    {
+        Engine e1;
+        Engine e2(Engine::default_seed);
+        assert(e1 == e2);
+        e2.seed(5);
+        assert(e1 != e2);
+        e1.seed(5);
+        assert(e1 == e2);
+        e1.seed();
+        assert(e1 == Engine());
+    }
+    {
+        std::seed_seq q1 = {1, 2, 3};
+        std::seed_seq q2 = {1, 2, 3};
+        Engine e1(q1);
+        Engine e2;
+        e2.seed(q2);
+        assert(e1 == e2);
+        assert(e1 != Engine());
+    }
+    {
+        const unsigned long long z[] = {0, 1, 2, 3, 4, 5, 7, 8, 9, 100, 1001};
+        for (int skip = 0; skip < 6; ++skip)
+        {
+            for (int j = 0; j < 11; ++j)
+            {
+                Engine e1(7);
+                e1.discard(skip);
+                Engine e2 = e1;
+                e1.discard(z[j]);
+                for (unsigned long long i = 0; i < z[j]; ++i)
+                    e2();
+                assert(e1 == e2);
+                assert(e1() == e2());
+            }
+        }
+    }
+    {
+        Engine e1(11);
+        for (int i = 0; i < 3; ++i)
+        {
+            e1();
+            std::ostringstream os;
+            os << e1;
+            std::istringstream is(os.str());
+            Engine e2;
+            is >> e2;
+            assert(e1 == e2);
+            for (int j = 0; j < 10; ++j)
+                assert(e1() == e2());
+        }
+    }
+    {
+        Engine e;
+        std::uniform_int_distribution<result_type> d1(3, 9);
+        std::normal_distribution<> d2;
+        std::generate_canonical<double, 53>(e);
+        for (int i = 0; i < 1000; ++i)
+        {
+            const result_type x = d1(e);
+            assert(3 <= x && x <= 9);
+            d2(e);
+        }
+    }
+}
+
+template <class Engine>
+void test_value(unsigned long long s, const unsigned long long* v, int n)
+{
+    Engine e(s);
+    for (int i = 0; i < n; ++i)
+        assert(e() == v[i]);
+}
+
+template <class Engine>
+void test_10000th(unsigned long long v)
+{
+    Engine e;
+    e.discard(9999);
+    assert(e() == v);
+    Engine e2;
+    for (int i = 0; i < 9999; ++i)
+        e2();
+    assert(e2() == v);
+}
+
+int main()
+{
+    test_engine<ex::splitmix64>();
+    test_engine<ex::xoshiro256starstar>();
+    test_engine<ex::pcg32>();
+    test_engine<ex::philox4x32>();
+    test_engine<ex::philox4x64>();
+    test_engine<ex::philox_engine<std::uint_fast32_t, 32, 2, 10, 0xD256D193, 0x9E3779B9> >();
+    test_engine<ex::philox_engine<std::uint_fast64_t, 48, 4, 7, 0xCA5A826395121157ull,
+                                  0x9E3779B97F4A7C15ull, 0xD2E7470EE14C6C93ull,
+                                  0xBB67AE8584CAA73Bull> >();
+    {
+        const unsigned long long v[] = {6457827717110365317ull, 3203168211198807973ull,
+                                        9817491932198370423ull};
+        test_value<ex::splitmix64>(1234567, v, 3);
+    }
+    {
+        const unsigned long long v[] = {12966619160104079557ull, 9600361134598540522ull,
+                                        10590380919521690900ull};
+        test_value<ex::xoshiro256starstar>(1, v, 3);
+    }
+    {
+        ex::pcg32 e(42, 54);
+        const unsigned long long v[] = {0xa15c02b7, 0x7b47f409, 0xba1d3330,
+                                        0x83d2f293, 0xbfa4784b, 0xcbed606e};
+        for (int i = 0; i < 6; ++i)
+            assert(e() == v[i]);
+        ex::pcg32 e2(42, 55);
+        assert(e != e2);
+        ex::pcg32 e3(42);
+        assert(e3 == ex::pcg32(42, ex::pcg32::default_increment >> 1));
+    }
+    test_10000th<ex::philox4x32>(1955073260);
+    test_10000th<ex::philox4x64>(3409172418970261260ull);
+    {
+        // Counters set apart give the same blocks as discarding the values
+        // in between, across a carry out of the low word.
+        ex::philox4x32 e1(3);
+        std::array<ex::philox4x32::result_type, 4> c = {{0, 0, 1, 0xFFFFFFFF}};
+        e1.set_counter(c);
+        ex::philox4x32 e2(3);
+        e2.discard(4 * 0x1FFFFFFFFull);
+        assert(e1 == e2);
+        for (int i = 0; i < 9; ++i)
+            assert(e1() == e2());
+        ex::philox4x64 e3;
+        ex::philox4x64 e4;
+        e3.discard(~0ull);
+        e3.discard(~0ull);
+        e3.discard(6);
+        e4.discard(5);
+        e4.discard(~0ull);
+        e4();
+        e4.discard(~0ull);
+        assert(e3 == e4);
+        assert(e3() == e4());
+    }
+}
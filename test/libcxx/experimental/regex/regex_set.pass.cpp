@@ -0,0 +1,146 @@
+//===----------------------------------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is dual licensed under the MIT and the University of Illinois Open
+// Source Licenses. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++98, c++03, c++11
+
+// <experimental/regex_set>
+
+// basic_regex_set: searching a set of regexes reports the same patterns as
+// searching for each of them in turn.
+
+#include <experimental/regex_set>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cassert>
+
+#include "count_new.hpp"
+
+namespace ex = std::experimental;
+
+typedef std::regex_constants::syntax_option_type syntax;
+typedef std::regex_constants::match_flag_type flags;
+
+struct pattern
+{
+    const char* p;
+    syntax f;
+};
+
+void check(const std::vector<std::regex>& rs, const ex::regex_set& set,
+           const std::string& s, flags f)
+{
+    std::vector<size_t> which;
+    std::vector<size_t> expected;
+    for (size_t i = 0; i < rs.size(); ++i)
+        if (std::regex_search(s, rs[i], f))
+            expected.push_back(i);
+    assert(ex::regex_search(s, set, which, f) == !expected.empty());
+    assert(which == expected);
+    assert(ex::regex_search(s.c_str(), set, which, f) == !expected.empty());
+    assert(which == expected);
+    assert(ex::regex_search(s.begin(), s.end(), set, which, f) == !expected.empty());
+    assert(which == expected);
+
+    expected.clear();
+    for (size_t i = 0; i < rs.size(); ++i)
+        if (std::regex_match(s, rs[i], f))
+            expected.push_back(i);
+    assert(ex::regex_match(s, set, which, f) == !expected.empty());
+    assert(which == expected);
+    assert(ex::regex_match(s.c_str(), set, which, f) == !expected.empty());
+    assert(which == expected);
+    assert(ex::regex_match(s.begin(), s.end(), set, which, f) == !expected.empty());
+    assert(which == expected);
+}
+
+int main()
+{
+    const syntax E = std::regex_constants::ECMAScript;
+    const pattern patterns[] = {
+        {"ab", E},
+        {"a+b", E},
+        {"^b", E},
+        {"c$", E},
+        {"\\bab", E},
+        {"b*", E},
+        {"(a|bc)+", E},
+        {"[^a ]{2}", E},
+        {"A[bc]", E | std::regex_constants::icase},
+        {"(a)\\1", E},
+        {"(?=b)bc", E},
+        {"(ab|a)(c|bcd)", std::regex_constants::extended},
+        {"\\(b\\)c*", std::regex_constants::basic},
+        {"ccc", E},
+        {"a.c", E},
+    };
+    std::vector<std::regex> rs;
+    for (size_t i = 0; i < sizeof(patterns) / sizeof(patterns[0]); ++i)
+        rs.push_back(std::regex(patterns[i].p, patterns[i].f));
+    const ex::regex_set set(rs.begin(), rs.end());
+    assert(set.size() == rs.size());
+    assert(!set.empty());
+    assert(set[3].mark_count() == 0 && set[11].mark_count() == 2);
+
+    const char alphabet[] = "abc d";
+    const flags fs[] = {std::regex_constants::match_default,
+                        std::regex_constants::match_not_null,
+                        std::regex_constants::match_continuous,
+                        std::regex_constants::match_not_bol |
+                        std::regex_constants::match_not_eol,
+                        std::regex_constants::match_not_bow};
+    std::srand(1);
+    for (int i = 0; i < 1000; ++i)
+    {
+        std::string s(std::rand() % 12, ' ');
+        for (std::string::size_type j = 0; j < s.size(); ++j)
+            s[j] = alphabet[std::rand() % (sizeof(alphabet) - 1)];
+        for (size_t f = 0; f < sizeof(fs) / sizeof(fs[0]); ++f)
+            check(rs, set, s, fs[f]);
+    }
+
+    // A set whose DFA has more states than a thread keeps, then searched in
+    // turn with another set.
+    std::vector<std::regex> big(1, std::regex("[ab]*a[ab]{16}c"));
+    big.push_back(std::regex("b[ab]{15}b$"));
+    const ex::regex_set bigset(big.begin(), big.end());
+    for (int i = 0; i < 20; ++i)
+    {
+        std::string s(6000, ' ');
+        for (std::string::size_type j = 0; j < s.size(); ++j)
+            s[j] = "abababababababac"[std::rand() % 16];
+        check(big, bigset, s, std::regex_constants::match_default);
+        if (i >= 18)
+            check(rs, set, s.substr(0, 12), std::regex_constants::match_default);
+    }
+
+    // An empty set matches nothing.
+    std::vector<size_t> which(1, 0);
+    const ex::regex_set none;
+    assert(none.empty());
+    assert(!ex::regex_search("abc", none, which));
+    assert(which.empty());
+
+    // Patterns can be added after the set is searched.
+    ex::wregex_set wset;
+    wset.push_back(std::wregex(L"x+"));
+    assert(!ex::regex_search(L"abc", wset, which));
+    wset.push_back(std::wregex(L"[\\u0100-\\u01FF]"));
+    wset.push_back(std::wregex(L"b"));
+    assert(ex::regex_search(L"abŐ", wset, which));
+    assert(which.size() == 2 && which[0] == 1 && which[1] == 2);
+
+    // Searching again does not allocate.
+    const std::string line = "ab cbc abd";
+    assert(ex::regex_search(line, set, which));
+    globalMemCounter.reset();
+    assert(ex::regex_search(line, set, which));
+    assert(ex::regex_search(line, set, which));
+    assert(globalMemCounter.checkNewCalledEq(0));
+}
@@ -0,0 +1,24 @@
+//===----------------------------------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is dual licensed under the MIT and the University of Illinois Open
+// Source Licenses. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++98, c++03, c++11
+
+// <experimental/static_regex>
+
+// An invalid pattern does not compile.
+
+#include <experimental/static_regex>
+
+constexpr char pattern[] = "(a|b";
+
+int main()
+{
+    std::experimental::static_regex<pattern> re; // expected-error@experimental/static_regex:* {{mismatched ( and )}}
+    (void)re;
+}
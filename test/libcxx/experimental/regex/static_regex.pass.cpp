@@ -0,0 +1,172 @@
+//===----------------------------------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is dual licensed under the MIT and the University of Illinois Open
+// Source Licenses. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++98, c++03, c++11
+
+// <experimental/static_regex>
+
+// basic_static_regex: a pattern parsed at compile time matches what the same
+// pattern matches in a basic_regex, with the same captures.
+
+#include <experimental/static_regex>
+#include <string>
+#include <cstdlib>
+#include <cassert>
+
+#include "test_iterators.h"
+
+namespace ex = std::experimental;
+
+typedef std::regex_constants::match_flag_type flags;
+
+template <class _Re>
+void compare(const _Re& sr, const std::regex& re, const std::string& s, flags f)
+{
+    std::smatch a, b;
+    bool x = ex::regex_search(s, a, sr, f);
+    assert(x == std::regex_search(s, b, re, f));
+    assert(x == ex::regex_search(s, sr, f));
+    assert(a.ready() && a.size() == b.size());
+    if (x)
+    {
+        assert(a.prefix() == b.prefix() && a.suffix() == b.suffix());
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            assert(a[i].matched == b[i].matched);
+            if (a[i].matched)
+                assert(a.position(i) == b.position(i) && a.length(i) == b.length(i));
+        }
+    }
+    x = ex::regex_match(s, a, sr, f);
+    assert(x == std::regex_match(s, b, re, f));
+    assert(x == ex::regex_match(s, sr, f));
+    assert(a.size() == b.size());
+    for (size_t i = 0; x && i < a.size(); ++i)
+    {
+        assert(a[i].matched == b[i].matched);
+        if (a[i].matched)
+            assert(a.position(i) == b.position(i) && a.length(i) == b.length(i));
+    }
+}
+
+template <const char* _Pattern>
+void check()
+{
+    const ex::static_regex<_Pattern> sr;
+    const std::regex re(_Pattern);
+    assert(sr.mark_count() == re.mark_count());
+    const char alphabet[] = "ab c1-_.";
+    const flags fs[] = {std::regex_constants::match_default,
+                        std::regex_constants::match_not_null,
+                        std::regex_constants::match_continuous,
+                        std::regex_constants::match_not_bol |
+                        std::regex_constants::match_not_eol,
+                        std::regex_constants::match_not_bow |
+                        std::regex_constants::match_not_eow};
+    std::srand(1);
+    for (int i = 0; i < 300; ++i)
+    {
+        std::string s(std::rand() % 8, ' ');
+        for (std::string::size_type j = 0; j < s.size(); ++j)
+            s[j] = alphabet[std::rand() % (sizeof(alphabet) - 1)];
+        for (size_t f = 0; f < sizeof(fs) / sizeof(fs[0]); ++f)
+            compare(sr, re, s, fs[f]);
+    }
+}
+
+constexpr char fields[] = "(\\w+)-(\\d+)";
+constexpr char alternation[] = "(a|ab)(c|bcd)(d*)";
+constexpr char empty_loop[] = "(a|)*b";
+constexpr char nested[] = "((a)|b)+";
+constexpr char lazy[] = "(a+?)(a*)";
+constexpr char counted[] = "a{2,3}?b|c{2}";
+constexpr char noncapturing[] = "(?:ab)*(c)?";
+constexpr char boundary[] = "\\b(\\w)\\w*\\b";
+constexpr char not_boundary[] = "\\Ba";
+constexpr char bare_not_boundary[] = "\\B";
+constexpr char end_boundary[] = "\\b$";
+constexpr char end_not_boundary[] = "\\B$";
+constexpr char backref[] = "(.)(.)\\2\\1";
+constexpr char anchors[] = "^(a|b)+$|c";
+constexpr char brackets[] = "[^ab][[:alpha:]_\\d-]*";
+constexpr char classes[] = "\\S\\s\\W\\D";
+constexpr char escapes[] = "\\x61\\u0062\\.|\\-";
+constexpr char nothing[] = "";
+constexpr char loops[] = "(a*)*|(b*)+c";
+
+constexpr wchar_t wide[] = L"(\\w+) ([\\u0100-\\u01FF]+)";
+
+int main()
+{
+    check<fields>();
+    check<alternation>();
+    check<empty_loop>();
+    check<nested>();
+    check<lazy>();
+    check<counted>();
+    check<noncapturing>();
+    check<boundary>();
+    check<not_boundary>();
+    check<backref>();
+    check<anchors>();
+    check<brackets>();
+    check<classes>();
+    check<escapes>();
+    check<nothing>();
+    check<loops>();
+
+    // The pattern is parsed at compile time.
+    constexpr ex::static_regex<fields> re;
+    static_assert(re.mark_count() == 2, "");
+    static_assert(re.flags() == std::regex_constants::ECMAScript, "");
+
+    {
+        const char* s = "id: abc-42;";
+        std::cmatch m;
+        assert(ex::regex_search(s, m, re));
+        assert(m.size() == 3);
+        assert(m.position(0) == 4 && m.length(0) == 6);
+        assert(m.str(1) == "abc" && m.str(2) == "42");
+        assert(m.prefix().str() == "id: " && m.suffix().str() == ";");
+        assert(!ex::regex_match(s, m, re));
+        assert(m.empty() && m.ready());
+        assert(ex::regex_match("abc-42", re));
+        assert(ex::regex_search(s, s + 9, re));
+        assert(!ex::regex_search(s, s + 8, re));
+    }
+    {
+        // Any bidirectional iterator.
+        const char s[] = "x yz-7";
+        typedef bidirectional_iterator<const char*> I;
+        std::match_results<I> m;
+        assert(ex::regex_search(I(s), I(s + 6), m, re));
+        assert(m.position(0) == 2 && m.length(2) == 1);
+        assert(ex::regex_match(I(s + 2), I(s + 6), m, re));
+        assert(m[1].first == I(s + 2) && m[1].second == I(s + 4));
+    }
+    {
+        // At the end of the input, \b and \B look at the character before it.
+        // basic_regex does not when the search reaches the end, so these are
+        // not compared with it.
+        std::cmatch m;
+        assert(!ex::regex_search("a", m, ex::static_regex<bare_not_boundary>()));
+        assert(!ex::regex_search("b _", m, ex::static_regex<bare_not_boundary>()));
+        assert(ex::regex_search("a", m, ex::static_regex<end_boundary>()));
+        assert(m.position(0) == 1 && m.length(0) == 0);
+        assert(!ex::regex_search("a", ex::static_regex<end_not_boundary>()));
+        assert(ex::regex_search("a ", ex::static_regex<end_not_boundary>()));
+        assert(ex::regex_search("", ex::static_regex<end_not_boundary>()));
+    }
+    {
+        std::wsmatch m;
+        const std::wstring s = L"x \x150\x151 y";
+        assert(ex::regex_search(s, m, ex::wstatic_regex<wide>()));
+        assert(m.str(1) == L"x" && m.str(2) == L"\x150\x151");
+    }
+}
@@ -0,0 +1,69 @@
+//===----------------------------------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is dual licensed under the MIT and the University of Illinois Open
+// Source Licenses. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++98, c++03, c++11
+// UNSUPPORTED: libcpp-no-exceptions
+
+// <experimental/static_regex>
+
+// Matching a basic_static_regex fails with error_complexity when it
+// backtracks more than _LIBCPP_REGEX_COMPLEXITY_FACTOR steps per character,
+// and with error_stack when its recursion would take more than
+// _LIBCPP_STATIC_REGEX_STACK_LIMIT bytes of stack.
+
+#include <experimental/static_regex>
+#include <string>
+#include <cassert>
+
+namespace ex = std::experimental;
+
+constexpr char either[] = "(?:a|b)*c";
+constexpr char twice[] = "(a|a)*b";
+constexpr char plain[] = "a*c";
+constexpr char short_loop[] = "(?:a|b)*";
+
+template <const char* _Pattern>
+std::regex_constants::error_type search(const std::string& s, bool& found)
+{
+    try
+    {
+        found = ex::regex_search(s, ex::static_regex<_Pattern>());
+    }
+    catch (const std::regex_error& e)
+    {
+        return e.code();
+    }
+    return std::regex_constants::error_type();
+}
+
+int main()
+{
+    bool found = false;
+    // Exponential backtracking.
+    assert(search<twice>(std::string(28, 'a'), found) ==
+           std::regex_constants::error_complexity);
+    assert(search<twice>(std::string(10, 'a') + "b", found) ==
+           std::regex_constants::error_type() && found);
+    // Long input through a loop that recurses per iteration.
+    assert(search<either>(std::string(100000, 'a'), found) ==
+           std::regex_constants::error_stack);
+    assert(search<either>(std::string(10000000, 'a'), found) ==
+           std::regex_constants::error_stack);
+    assert(search<either>(std::string(100, 'a') + "c", found) ==
+           std::regex_constants::error_type() && found);
+    {
+        std::smatch m;
+        const std::string s = std::string(100, 'b') + "x";
+        assert(ex::regex_search(s, m, ex::static_regex<short_loop>()));
+        assert(m.length(0) == 100);
+    }
+    // A loop over one character does not recurse per iteration.
+    assert(search<plain>(std::string(10000000, 'a') + "c", found) ==
+           std::regex_constants::error_type() && found);
+}
@@ -0,0 +1,111 @@
+//===----------------------------------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is dual licensed under the MIT and the University of Illinois Open
+// Source Licenses. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// XFAIL: availability
+
+// <fstream>
+
+// Test the libc++ extension ios_base::__mmap: read-only filebufs opened with
+// it are served from a memory mapping of the file when possible.
+
+#include <fstream>
+#include <string>
+#include <cstdio>
+#include <cassert>
+
+#include "platform_support.h" // get_temp_file_name
+
+template <class CharT>
+struct test_buf
+    : public std::basic_filebuf<CharT>
+{
+    typedef std::basic_filebuf<CharT> base;
+    typedef typename base::char_type  char_type;
+
+    char_type* eback() const {return base::eback();}
+    char_type* gptr()  const {return base::gptr();}
+    char_type* egptr() const {return base::egptr();}
+};
+
+int main()
+{
+    std::string temp = get_temp_file_name();
+    {
+        std::ofstream out(temp.c_str());
+        for (int i = 0; i < 1000; ++i)
+            out << "0123456789";
+    }
+    {
+        test_buf<char> f;
+        assert(f.open(temp.c_str(), std::ios_base::in | std::ios_base::__mmap) != 0);
+        // The get area covers the whole file.
+        assert(f.egptr() - f.eback() == 10000);
+        assert(f.gptr() == f.eback());
+        assert(f.sgetc() == '0');
+        assert(f.sbumpc() == '0');
+        assert(f.sgetc() == '1');
+        assert(f.sungetc() == '0');
+        assert(f.sputbackc('x') == std::char_traits<char>::eof());
+        char buf[25] = {};
+        assert(f.sgetn(buf, 24) == 24);
+        assert(std::string(buf) == "012345678901234567890123");
+        assert(f.pubseekoff(0, std::ios_base::cur, std::ios_base::in) == 24);
+        assert(f.pubseekoff(-3, std::ios_base::end, std::ios_base::in) == 9997);
+        assert(f.sgetn(buf, 24) == 3);
+        assert(f.sgetc() == std::char_traits<char>::eof());
+        assert(f.pubseekpos(5, std::ios_base::in) == 5);
+        assert(f.sgetc() == '5');
+        assert(f.pubseekoff(1, std::ios_base::end, std::ios_base::in) == -1);
+        assert(f.sputc('a') == std::char_traits<char>::eof());
+        assert(f.close() != 0);
+        assert(!f.is_open());
+    }
+    {
+        std::ifstream fs(temp.c_str(), std::ios_base::__mmap);
+        std::string s;
+        std::getline(fs, s);
+        assert(s.size() == 10000);
+        assert(s.compare(9990, 10, "0123456789") == 0);
+        assert(fs.eof());
+    }
+    {
+        // ate starts at the end of the mapping.
+        test_buf<char> f;
+        assert(f.open(temp.c_str(), std::ios_base::in | std::ios_base::ate |
+                                    std::ios_base::__mmap) != 0);
+        assert(f.pubseekoff(0, std::ios_base::cur, std::ios_base::in) == 10000);
+    }
+    {
+        // Writable and converting filebufs ignore the flag.
+        test_buf<char> f;
+        assert(f.open(temp.c_str(), std::ios_base::in | std::ios_base::out |
+                                    std::ios_base::__mmap) != 0);
+        assert(f.eback() == 0);
+        assert(f.sgetc() == '0');
+        assert(f.egptr() - f.eback() < 10000);
+
+        test_buf<wchar_t> w;
+        assert(w.open(temp.c_str(), std::ios_base::in | std::ios_base::__mmap) != 0);
+        assert(w.eback() == 0);
+        assert(w.sgetc() == L'0');
+    }
+    {
+        // Moving and swapping keep the mapped get area.
+        std::filebuf f;
+        assert(f.open(temp.c_str(), std::ios_base::in | std::ios_base::__mmap) != 0);
+        assert(f.pubseekpos(7, std::ios_base::in) == 7);
+        std::filebuf g(std::move(f));
+        assert(!f.is_open());
+        assert(g.sgetc() == '7');
+        std::filebuf h;
+        h.swap(g);
+        assert(h.sgetc() == '7');
+    }
+    std::remove(temp.c_str());
+}
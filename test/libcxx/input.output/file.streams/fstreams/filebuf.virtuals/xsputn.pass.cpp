@@ -0,0 +1,93 @@
+//===----------------------------------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is dual licensed under the MIT and the University of Illinois Open
+// Source Licenses. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// <fstream>
+
+// streamsize xsputn(const char_type* s, streamsize n);
+
+// libc++ writes spans at least as large as the buffer directly to the file.
+
+#include <fstream>
+#include <string>
+#include <cstdio>
+#include <cassert>
+
+#include "platform_support.h" // get_temp_file_name
+
+struct test_buf
+    : public std::filebuf
+{
+    char* pbase() const {return std::filebuf::pbase();}
+    char* pptr()  const {return std::filebuf::pptr();}
+};
+
+std::string expected(std::size_t n)
+{
+    std::string s;
+    for (std::size_t i = 0; i < n; ++i)
+        s += static_cast<char>('a' + i % 26);
+    return s;
+}
+
+std::string contents(const std::string& name)
+{
+    std::ifstream in(name.c_str());
+    return std::string(std::istreambuf_iterator<char>(in),
+                       std::istreambuf_iterator<char>());
+}
+
+int main()
+{
+    std::string temp = get_temp_file_name();
+    const std::string big = expected(100000);
+    {
+        test_buf f;
+        assert(f.open(temp.c_str(), std::ios_base::out) != 0);
+        assert(f.sputn("xyz", 3) == 3);
+        assert(f.pptr() - f.pbase() == 3);
+        assert(f.sputn(big.data(), big.size()) == static_cast<std::streamsize>(big.size()));
+        // The pending output was flushed and the span bypassed the buffer.
+        assert(f.pptr() == f.pbase());
+        assert(f.sputn("!", 1) == 1);
+        assert(f.close() != 0);
+        assert(contents(temp) == "xyz" + big + "!");
+    }
+    {
+        // A user supplied buffer bounds what is copied through it.
+        char buf[64];
+        test_buf f;
+        assert(f.pubsetbuf(buf, sizeof(buf)) != 0);
+        assert(f.open(temp.c_str(), std::ios_base::out) != 0);
+        for (std::size_t i = 0; i < big.size(); i += 100)
+            assert(f.sputn(big.data() + i, 100) == 100);
+        assert(f.sputn(big.data(), 10) == 10);
+        assert(f.pbase() == buf);
+        assert(f.close() != 0);
+        assert(contents(temp) == big + big.substr(0, 10));
+    }
+    {
+        // Unbuffered filebufs write whole spans at once.
+        test_buf f;
+        assert(f.pubsetbuf(0, 0) != 0);
+        assert(f.open(temp.c_str(), std::ios_base::out) != 0);
+        assert(f.sputn(big.data(), 5000) == 5000);
+        assert(f.sputn("ab", 2) == 2);
+        assert(f.close() != 0);
+        assert(contents(temp) == big.substr(0, 5000) + "ab");
+    }
+    {
+        std::ofstream out(temp.c_str());
+        out << 'x';
+        out.write(big.data(), big.size());
+        out << 'y';
+        out.close();
+        assert(contents(temp) == "x" + big + "y");
+    }
+    std::remove(temp.c_str());
+}
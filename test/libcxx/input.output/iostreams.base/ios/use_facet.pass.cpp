@@ -0,0 +1,79 @@
+//===----------------------------------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is dual licensed under the MIT and the University of Illinois Open
+// Source Licenses. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// <ios>
+
+// template <class Facet> const Facet& basic_ios::__use_facet() const;
+
+// The facets used by formatted I/O may be cached per stream. Check that the
+// cache follows every way of changing the locale of a stream.
+
+#include <sstream>
+#include <locale>
+#include <string>
+#include <cassert>
+
+struct comma : std::numpunct<char>
+{
+    char do_decimal_point() const {return ',';}
+};
+
+struct dash : std::numpunct<char>
+{
+    char do_decimal_point() const {return '-';}
+};
+
+std::string put(std::ostringstream& os, double d)
+{
+    os.str("");
+    os << d;
+    return os.str();
+}
+
+int main()
+{
+    const std::locale lc(std::locale::classic(), new comma);
+    const std::locale ld(std::locale::classic(), new dash);
+    {
+        std::ostringstream os;
+        assert(put(os, 1.5) == "1.5");
+        assert(&os.__use_facet<std::numpunct<char> >() ==
+               &std::use_facet<std::numpunct<char> >(std::locale::classic()));
+        os.imbue(lc);
+        assert(put(os, 1.5) == "1,5");
+        assert(&os.__use_facet<std::numpunct<char> >() ==
+               &std::use_facet<std::numpunct<char> >(lc));
+        static_cast<std::ios_base&>(os).imbue(ld);
+        assert(put(os, 1.5) == "1-5");
+    }
+    {
+        std::ostringstream a;
+        std::ostringstream b;
+        a.imbue(lc);
+        assert(put(a, 2.5) == "2,5");
+        assert(put(b, 2.5) == "2.5");
+        b.copyfmt(a);
+        assert(put(b, 2.5) == "2,5");
+        a.swap(b);
+        b.imbue(ld);
+        assert(put(a, 2.5) == "2,5");
+        assert(put(b, 2.5) == "2-5");
+        std::ostringstream c(std::move(b));
+        assert(put(c, 2.5) == "2-5");
+    }
+    {
+        std::istringstream is("3,25");
+        is.imbue(lc);
+        double d = 0;
+        is >> d;
+        assert(d == 3.25);
+        assert(is.widen('x') == 'x');
+        assert(is.narrow('y', '?') == 'y');
+    }
+}
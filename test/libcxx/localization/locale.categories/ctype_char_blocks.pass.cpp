@@ -0,0 +1,117 @@
+//===----------------------------------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is dual licensed under the MIT and the University of Illinois Open
+// Source Licenses. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// <locale>
+
+// template <> class ctype<char>
+
+// scan_is, scan_not, toupper and tolower process long ranges in blocks when
+// the facet uses the classic table.  Check them against the table for every
+// character at every position of a block, and check that a facet with its own
+// table still uses that table.
+
+#include <locale>
+#include <string>
+#include <cassert>
+
+typedef std::ctype<char> F;
+
+struct TableCtype : F
+{
+    explicit TableCtype(const mask* tab) : F(tab) {}
+};
+
+const F::mask masks[] = {
+    F::space, F::print, F::cntrl, F::upper, F::lower, F::alpha, F::digit,
+    F::punct, F::xdigit, F::blank, F::alnum, F::graph,
+    F::upper | F::digit, F::space | F::punct, F::cntrl | F::xdigit,
+    F::lower | F::blank | F::print, 0
+};
+
+bool matches(const F& f, F::mask m, char c)
+{
+    return isascii(c) && (f.table()[static_cast<unsigned char>(c)] & m) != 0;
+}
+
+void test_scan(const F& f)
+{
+    for (std::size_t k = 0; k < sizeof(masks) / sizeof(masks[0]); ++k)
+    {
+        F::mask m = masks[k];
+        for (int c = 0; c < 256; ++c)
+        {
+            for (std::size_t pos = 0; pos < 40; pos += 3)
+            {
+                // A run of characters that match m (or do not) with c at pos.
+                char filler_is = 0, filler_not = 0;
+                for (int d = 0; d < 128; ++d)
+                {
+                    if (!filler_not && !matches(f, m, static_cast<char>(d)))
+                        filler_not = static_cast<char>(d);
+                    if (!filler_is && matches(f, m, static_cast<char>(d)))
+                        filler_is = static_cast<char>(d);
+                }
+                if (filler_not)
+                {
+                    std::string s(40, filler_not);
+                    s[pos] = static_cast<char>(c);
+                    const char* p = f.scan_is(m, s.data(), s.data() + s.size());
+                    if (matches(f, m, static_cast<char>(c)))
+                        assert(p == s.data() + pos);
+                    else
+                        assert(p == s.data() + s.size());
+                }
+                if (filler_is)
+                {
+                    std::string s(40, filler_is);
+                    s[pos] = static_cast<char>(c);
+                    const char* p = f.scan_not(m, s.data(), s.data() + s.size());
+                    if (matches(f, m, static_cast<char>(c)))
+                        assert(p == s.data() + s.size());
+                    else
+                        assert(p == s.data() + pos);
+                }
+            }
+        }
+    }
+}
+
+int main()
+{
+    const F& f = std::use_facet<F>(std::locale::classic());
+    test_scan(f);
+    {
+        std::string s;
+        for (int i = 0; i < 1000; ++i)
+            s += static_cast<char>(i * 7);
+        std::string u = s, l = s;
+        assert(f.toupper(&u[0], u.data() + u.size()) == u.data() + u.size());
+        assert(f.tolower(&l[0], l.data() + l.size()) == l.data() + l.size());
+        for (std::size_t i = 0; i < s.size(); ++i)
+        {
+            assert(u[i] == f.toupper(s[i]));
+            assert(l[i] == f.tolower(s[i]));
+        }
+    }
+    {
+        // Swap the classification of letters and digits.
+        static F::mask tab[F::table_size];
+        for (std::size_t i = 0; i < F::table_size; ++i)
+            tab[i] = F::classic_table()[i];
+        for (int c = 'a'; c <= 'z'; ++c)
+            tab[c] = F::digit;
+        for (int c = '0'; c <= '9'; ++c)
+            tab[c] = F::lower | F::alpha;
+        TableCtype g(tab);
+        test_scan(g);
+        std::string s = "0123456789012345678901234567890123456789a";
+        assert(g.scan_not(F::alpha, s.data(), s.data() + s.size()) ==
+               s.data() + s.size() - 1);
+    }
+}
@@ -0,0 +1,113 @@
+//===----------------------------------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is dual licensed under the MIT and the University of Illinois Open
+// Source Licenses. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// <codecvt>
+
+// The UTF-8 transcoders convert runs of ASCII in blocks.  Check that runs
+// longer than a block are converted correctly when they are interrupted by
+// non-ASCII characters, by the end of the input, or by the end of the output,
+// and that code units above Maxcode are still rejected.
+
+#include <codecvt>
+#include <string>
+#include <cassert>
+
+template <class CharT>
+void test(const std::codecvt<CharT, char, std::mbstate_t>& cvt)
+{
+    for (std::size_t len = 0; len < 70; ++len)
+    {
+        for (std::size_t pos = 0; pos <= len; ++pos)
+        {
+            // len ASCII characters with U+00E9 inserted at pos.
+            std::string ext;
+            std::basic_string<CharT> in;
+            for (std::size_t i = 0; i < len; ++i)
+            {
+                if (i == pos)
+                {
+                    ext += "\xC3\xA9";
+                    in += CharT(0xE9);
+                }
+                ext += char('!' + i % 90);
+                in += CharT('!' + i % 90);
+            }
+
+            for (std::size_t cap = 0; cap <= in.size(); cap += 7)
+            {
+                std::mbstate_t m = std::mbstate_t();
+                CharT out[80];
+                const char* frm_nxt;
+                CharT* to_nxt;
+                std::codecvt_base::result r =
+                    cvt.in(m, ext.data(), ext.data() + ext.size(), frm_nxt,
+                           out, out + cap, to_nxt);
+                std::size_t n = to_nxt - out;
+                assert(n == (cap < in.size() ? cap : in.size()));
+                assert(r == (n == in.size() ? std::codecvt_base::ok
+                                            : std::codecvt_base::partial));
+                assert(std::basic_string<CharT>(out, n) == in.substr(0, n));
+                assert(frm_nxt - ext.data() ==
+                       static_cast<std::ptrdiff_t>(n + (n > pos ? 1 : 0)));
+
+                m = std::mbstate_t();
+                assert(cvt.length(m, ext.data(), ext.data() + ext.size(), cap) ==
+                       frm_nxt - ext.data());
+            }
+
+            for (std::size_t cap = 0; cap <= ext.size(); cap += 5)
+            {
+                std::mbstate_t m = std::mbstate_t();
+                char out[80];
+                const CharT* frm_nxt;
+                char* to_nxt;
+                std::codecvt_base::result r =
+                    cvt.out(m, in.data(), in.data() + in.size(), frm_nxt,
+                            out, out + cap, to_nxt);
+                std::size_t n = to_nxt - out;
+                assert(r == (n == ext.size() ? std::codecvt_base::ok
+                                             : std::codecvt_base::partial));
+                assert(std::string(out, n) == ext.substr(0, n));
+                assert(n + 2 > cap);
+            }
+        }
+    }
+}
+
+int main()
+{
+    test(std::codecvt_utf8<char16_t>());
+    test(std::codecvt_utf8<char32_t>());
+    test(std::codecvt_utf8<wchar_t>());
+    test(std::codecvt_utf8_utf16<char16_t>());
+    test(std::codecvt_utf8_utf16<char32_t>());
+    {
+        // Maxcode below 0x7F still stops at the first code unit above it.
+        std::codecvt_utf8<char32_t, 0x60> cvt;
+        std::string ext(40, 'A');
+        ext[30] = 'z';
+        std::mbstate_t m = std::mbstate_t();
+        char32_t out[40];
+        const char* frm_nxt;
+        char32_t* to_nxt;
+        assert(cvt.in(m, ext.data(), ext.data() + ext.size(), frm_nxt,
+                      out, out + 40, to_nxt) == std::codecvt_base::error);
+        assert(to_nxt - out == 30);
+        assert(cvt.length(m, ext.data(), ext.data() + ext.size(), 40) == 30);
+
+        std::u32string in(40, U'A');
+        in[30] = U'z';
+        const char32_t* ifrm_nxt;
+        char ext_out[40];
+        char* ext_nxt;
+        assert(cvt.out(m, in.data(), in.data() + in.size(), ifrm_nxt,
+                       ext_out, ext_out + 40, ext_nxt) == std::codecvt_base::error);
+        assert(ifrm_nxt - in.data() == 30);
+    }
+}
@@ -265,12 +265,18 @@ TEST_MACROS();
 TEST_MACROS();
 #include <experimental/propagate_const>
 TEST_MACROS();
+#include <experimental/random>
+TEST_MACROS();
 #include <experimental/ratio>
 TEST_MACROS();
 #include <experimental/regex>
 TEST_MACROS();
+#include <experimental/regex_set>
+TEST_MACROS();
 #include <experimental/set>
 TEST_MACROS();
+#include <experimental/static_regex>
+TEST_MACROS();
 #include <experimental/string>
 TEST_MACROS();
 #include <experimental/string_view>
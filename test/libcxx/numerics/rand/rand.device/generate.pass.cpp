@@ -0,0 +1,81 @@
+//===----------------------------------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is dual licensed under the MIT and the University of Illinois Open
+// Source Licenses. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// XFAIL: availability
+
+// <random>
+
+// class random_device;
+
+// template <class ForwardIterator>
+//     void __generate(ForwardIterator first, ForwardIterator last);
+// void __fill(result_type* first, result_type* last);
+
+// Filling a range of any kind sets every element, and calls of operator()
+// between fills and after them go on giving values.
+
+#include <random>
+#include <list>
+#include <vector>
+#include <cassert>
+
+// The chance that n values from the device are all equal to the first of
+// them is 2^(-32 * (n - 1)).
+template <class Iter>
+bool all_equal(Iter first, Iter last)
+{
+    for (Iter i = first; i != last; ++i)
+        if (*i != *first)
+            return false;
+    return true;
+}
+
+int main()
+{
+    static_assert((std::__has_generate<std::random_device>::value), "");
+    std::random_device r;
+    const std::size_t lengths[] = {2, 3, 63, 64, 65, 1000, 100000};
+    for (std::size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); ++i)
+    {
+        std::vector<unsigned> v(lengths[i], 0);
+        std::__generate_random(r, v.begin(), v.end());
+        assert(!all_equal(v.begin(), v.end()));
+        assert(v[lengths[i] - 1] != 0 || v[lengths[i] - 2] != 0);
+        std::list<unsigned> l(lengths[i], 0);
+        std::__generate_random(r, l.begin(), l.end());
+        assert(!all_equal(l.begin(), l.end()));
+        std::vector<unsigned long long> w(lengths[i], 0);
+        r.__generate(w.begin(), w.end());
+        assert(!all_equal(w.begin(), w.end()));
+        unsigned a[3] = {r(), r(), r()};
+        assert(!all_equal(a, a + 3));
+    }
+    {
+        unsigned a[1] = {0};
+        r.__generate(a, a);
+        assert(a[0] == 0);
+    }
+    {
+        std::random_device r2("/dev/urandom");
+        unsigned a[200];
+        for (int i = 0; i < 200; ++i)
+            a[i] = r2();
+        assert(!all_equal(a, a + 200));
+        r2.__generate(a, a + 200);
+        assert(!all_equal(a, a + 200));
+        for (int i = 0; i < 200; ++i)
+            a[i] = 0;
+        r2.__fill(a, a + 200);
+        assert(!all_equal(a, a + 200));
+        r.__generate(a, a + 8);
+        std::seed_seq s(a, a + 8);
+        std::mt19937 g(s);
+        g();
+    }
+}
@@ -0,0 +1,129 @@
+//===----------------------------------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is dual licensed under the MIT and the University of Illinois Open
+// Source Licenses. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// <random>
+
+// With _LIBCPP_ABI_DISCRETE_ALIAS_TABLE, discrete_distribution and
+// piecewise_constant_distribution pick the outcome or the interval from an
+// alias table, and by a binary search otherwise.  Check the frequency of each
+// outcome, that outcomes of weight zero never come up, and that a distribution
+// read back from a stream draws the same values.
+
+#include <random>
+#include <sstream>
+#include <vector>
+#include <cassert>
+#include <cmath>
+
+void check_count(long count, long N, double p)
+{
+    // Five standard deviations of the count.
+    const double sd = std::sqrt(N * p * (1 - p));
+    assert(std::abs(count - N * p) < 5 * sd + 1);
+}
+
+template <class G>
+void test_discrete(const double* w, int n)
+{
+    std::discrete_distribution<> d(w, w + n);
+    G g;
+    const long N = 1000000;
+    std::vector<long> count(n);
+    for (long i = 0; i < N; ++i)
+    {
+        const int x = d(g);
+        assert(0 <= x && x < n);
+        ++count[x];
+    }
+    double s = 0;
+    for (int k = 0; k < n; ++k)
+        s += w[k];
+    for (int k = 0; k < n; ++k)
+    {
+        if (w[k] == 0)
+            assert(count[k] == 0);
+        else
+            check_count(count[k], N, w[k] / s);
+    }
+}
+
+int main()
+{
+    {
+        const double w[] = {1, 0, 2, 0.5, 0, 30, 1e-3, 7};
+        test_discrete<std::mt19937>(w, 8);
+        test_discrete<std::mt19937_64>(w, 8);
+        test_discrete<std::minstd_rand>(w, 8);
+        const double w2[] = {0, 0, 1};
+        test_discrete<std::mt19937>(w2, 3);
+        const double w3[] = {1, 1, 1, 1, 1};
+        test_discrete<std::mt19937>(w3, 5);
+    }
+    {
+        // Many outcomes, with the weights rising along them.
+        const int n = 10000;
+        std::vector<double> w(n);
+        for (int k = 0; k < n; ++k)
+            w[k] = k % 100 + 1;
+        std::discrete_distribution<> d(w.begin(), w.end());
+        std::mt19937 g;
+        const long N = 2000000;
+        long count[100] = {0};
+        for (long i = 0; i < N; ++i)
+            ++count[d(g) % 100];
+        for (int k = 0; k < 100; ++k)
+            check_count(count[k], N, (k + 1) / 5050.);
+    }
+    {
+        const double w[] = {1, 0, 2, 0.5};
+        std::discrete_distribution<> d1(w, w + 4);
+        std::ostringstream os;
+        os << d1;
+        std::istringstream is(os.str());
+        std::discrete_distribution<> d2;
+        is >> d2;
+        assert(d1 == d2);
+        std::mt19937 g1;
+        std::mt19937 g2;
+        for (int i = 0; i < 1000; ++i)
+            assert(d1(g1) == d2(g2));
+    }
+    {
+        const double b[] = {-1, 0, 0.5, 3, 4};
+        const double w[] = {1, 0, 2, 5};
+        std::piecewise_constant_distribution<> d(b, b + 5, w);
+        std::mt19937 g;
+        const long N = 1000000;
+        long count[5] = {0};
+        for (long i = 0; i < N; ++i)
+        {
+            const double x = d(g);
+            assert(-1 <= x && x < 4);
+            assert(!(0 <= x && x < 0.5));
+            ++count[x < 0 ? 0 : x < 3 ? 2 : 3];
+            if (1 <= x && x < 2)
+                ++count[4];
+        }
+        // The weights are the probabilities of the intervals.
+        check_count(count[0], N, 1 / 8.);
+        check_count(count[2], N, 2 / 8.);
+        check_count(count[3], N, 5 / 8.);
+        // A part of the interval [0.5, 3).
+        check_count(count[4], N, 2 / 8. / 2.5);
+        std::ostringstream os;
+        os << d;
+        std::istringstream is(os.str());
+        std::piecewise_constant_distribution<> d2;
+        is >> d2;
+        assert(d == d2);
+        std::mt19937 g2 = g;
+        for (int i = 0; i < 1000; ++i)
+            assert(d(g) == d2(g2));
+    }
+}
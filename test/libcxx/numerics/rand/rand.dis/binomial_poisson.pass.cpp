@@ -0,0 +1,135 @@
+//===----------------------------------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is dual licensed under the MIT and the University of Illinois Open
+// Source Licenses. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// <random>
+
+// binomial_distribution draws with BTRD when t p (1 - p) is 50 or more, and
+// poisson_distribution by inversion when the mean is below 10.  Check the
+// probability of falling in each of a few intervals against the exact
+// probabilities, with intervals near the mode, where BTRD takes the ratio of
+// the probabilities, and far from it, where it takes Stirling's formula.
+
+#include <random>
+#include <cassert>
+#include <cmath>
+
+template <class D, class G>
+void check_intervals(D d, G g, const long* edges, const double* p, int n)
+{
+    const long N = 1000000;
+    long count[8] = {0};
+    for (long i = 0; i < N; ++i)
+    {
+        const long x = static_cast<long>(d(g));
+        assert(d.min() <= x && x <= d.max());
+        for (int j = 0; j < n; ++j)
+            if (edges[j] <= x && x < edges[j + 1])
+                ++count[j];
+    }
+    for (int j = 0; j < n; ++j)
+    {
+        // Five standard deviations of the count.
+        const double sd = std::sqrt(N * p[j] * (1 - p[j]));
+        assert(std::abs(count[j] - N * p[j]) < 5 * sd + 1);
+    }
+}
+
+double binomial_pmf(long t, double p, long k)
+{
+    return std::exp(std::lgamma(t + 1.) - std::lgamma(k + 1.) - std::lgamma(t - k + 1.) +
+                    k * std::log(p) + (t - k) * std::log(1 - p));
+}
+
+double poisson_pmf(double mean, long k)
+{
+    return std::exp(k * std::log(mean) - mean - std::lgamma(k + 1.));
+}
+
+template <class Pmf>
+void probabilities(const long* edges, double* p, int n, Pmf pmf)
+{
+    for (int j = 0; j < n; ++j)
+    {
+        p[j] = 0;
+        for (long k = edges[j]; k < edges[j + 1]; ++k)
+            p[j] += pmf(k);
+    }
+}
+
+struct binomial
+{
+    long t;
+    double p;
+    double operator()(long k) const {return binomial_pmf(t, p, k);}
+};
+
+struct poisson
+{
+    double mean;
+    double operator()(long k) const {return poisson_pmf(mean, k);}
+};
+
+int main()
+{
+    {
+        // The mode is 300 and the standard deviation 14.5.
+        const long e[] = {0, 250, 280, 295, 300, 301, 316, 340, 1001};
+        const binomial b = {1000, 0.3};
+        double p[8];
+        probabilities(e, p, 8, b);
+        check_intervals(std::binomial_distribution<>(1000, 0.3), std::mt19937(), e, p, 8);
+        check_intervals(std::binomial_distribution<long>(1000, 0.3), std::mt19937_64(), e, p, 8);
+        check_intervals(std::binomial_distribution<>(1000, 0.3), std::minstd_rand(), e, p, 8);
+    }
+    {
+        // 1 - p is below one half.
+        const long e[] = {0, 900, 920, 930, 940, 950, 960, 980, 1001};
+        const binomial b = {1000, 0.94};
+        double p[8];
+        probabilities(e, p, 8, b);
+        check_intervals(std::binomial_distribution<>(1000, 0.94), std::mt19937(), e, p, 8);
+    }
+    {
+        // Just below the variance of 50, by the modal search.
+        const long e[] = {0, 90, 95, 98, 99, 100, 105, 110, 200};
+        const binomial b = {199, 0.5};
+        double p[8];
+        probabilities(e, p, 8, b);
+        check_intervals(std::binomial_distribution<>(199, 0.5), std::mt19937(), e, p, 8);
+    }
+    {
+        std::binomial_distribution<unsigned long long> d(1ull << 40, 0.25);
+        std::mt19937_64 g;
+        double m = 0;
+        for (int i = 0; i < 10000; ++i)
+        {
+            const unsigned long long x = d(g);
+            assert(x <= d.max());
+            m += x;
+        }
+        // Five standard deviations of the mean.
+        const double t = 1ull << 40;
+        assert(std::abs(m / 10000 - t * 0.25) < 5 * std::sqrt(t * 0.1875 / 10000));
+    }
+    {
+        const long e[] = {0, 1, 2, 3, 5, 8, 1000};
+        const poisson q = {0.5};
+        double p[6];
+        probabilities(e, p, 6, q);
+        check_intervals(std::poisson_distribution<>(0.5), std::mt19937(), e, p, 6);
+    }
+    {
+        const long e[] = {0, 3, 6, 8, 9, 10, 13, 20, 1000};
+        const poisson q = {9.5};
+        double p[8];
+        probabilities(e, p, 8, q);
+        check_intervals(std::poisson_distribution<>(9.5), std::mt19937(), e, p, 8);
+        check_intervals(std::poisson_distribution<short>(9.5), std::ranlux24(), e, p, 8);
+    }
+}
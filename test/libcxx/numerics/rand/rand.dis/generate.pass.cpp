@@ -0,0 +1,98 @@
+//===----------------------------------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is dual licensed under the MIT and the University of Illinois Open
+// Source Licenses. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// <random>
+
+// template <class URNG, class ForwardIterator>
+//     void __generate(URNG& g, ForwardIterator first, ForwardIterator last);
+// template <class URNG, class ForwardIterator>
+//     void __generate(URNG& g, ForwardIterator first, ForwardIterator last,
+//                     const param_type& p);
+
+// uniform_int_distribution, uniform_real_distribution, bernoulli_distribution
+// and normal_distribution fill a range with the values of as many calls of
+// operator(), and leave the engine and the distribution where those calls
+// would, whatever the engine and the length of the range.
+
+#include <random>
+#include <list>
+#include <sstream>
+#include <vector>
+#include <cassert>
+
+template <class Dist, class Engine>
+void check(Dist d1, std::size_t skip, std::size_t length)
+{
+    typedef typename Dist::result_type result_type;
+    Engine g1;
+    g1.discard(skip);
+    Engine g2 = g1;
+    Dist d2 = d1;
+    std::vector<result_type> v(length);
+    d1.__generate(g1, v.begin(), v.end());
+    for (std::size_t k = 0; k < length; ++k)
+        assert(v[k] == d2(g2));
+    assert(g1 == g2);
+    assert(d1 == d2);
+    std::list<result_type> l(length);
+    d1.__generate(g1, l.begin(), l.end(), d1.param());
+    for (typename std::list<result_type>::iterator k = l.begin(); k != l.end(); ++k)
+        assert(*k == d2(g2, d2.param()));
+    assert(g1 == g2);
+    assert(d1 == d2);
+    assert(d1(g1) == d2(g2));
+}
+
+template <class Dist, class Engine>
+void test(Dist d)
+{
+    const std::size_t skips[] = {0, 1, 23};
+    const std::size_t lengths[] = {0, 1, 2, 63, 64, 65, 127, 128, 129, 1000};
+    for (std::size_t i = 0; i < sizeof(skips) / sizeof(skips[0]); ++i)
+        for (std::size_t j = 0; j < sizeof(lengths) / sizeof(lengths[0]); ++j)
+            check<Dist, Engine>(d, skips[i], lengths[j]);
+}
+
+template <class Dist>
+void test_engines(Dist d)
+{
+    test<Dist, std::minstd_rand>(d);
+    test<Dist, std::mt19937>(d);
+    test<Dist, std::mt19937_64>(d);
+    test<Dist, std::ranlux24>(d);
+    test<Dist, std::knuth_b>(d);
+}
+
+int main()
+{
+    test_engines(std::uniform_int_distribution<>(0, 9));
+    test_engines(std::uniform_int_distribution<>(-5, -5));
+    test_engines(std::uniform_int_distribution<long long>(-3, 1ll << 40));
+    test_engines(std::uniform_int_distribution<unsigned long long>());
+    // Two thirds of the words are rejected.
+    test_engines(std::uniform_int_distribution<unsigned>(0, 0xAAAAAAAAu));
+    test_engines(std::uniform_real_distribution<>(-2, 3));
+    test_engines(std::uniform_real_distribution<float>(0, 1));
+    test_engines(std::uniform_real_distribution<long double>(1, 2));
+    test_engines(std::bernoulli_distribution(0.3));
+    test_engines(std::normal_distribution<>(1, 2));
+    test_engines(std::normal_distribution<float>());
+    test_engines(std::normal_distribution<long double>(3, 4));
+    {
+        // With a value kept from the polar method.
+        std::normal_distribution<long double> d;
+        std::mt19937 g;
+        d(g);
+        test<std::normal_distribution<long double>, std::mt19937>(d);
+        std::istringstream in("0 1 1 0.5");
+        std::normal_distribution<> d2;
+        in >> d2;
+        test<std::normal_distribution<>, std::mt19937_64>(d2);
+    }
+}
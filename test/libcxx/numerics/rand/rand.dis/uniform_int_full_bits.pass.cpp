@@ -0,0 +1,99 @@
+//===----------------------------------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is dual licensed under the MIT and the University of Illinois Open
+// Source Licenses. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++98, c++03
+// <random>
+
+// uniform_int_distribution maps a word of an engine that returns 32 or 64
+// random bits to the range with a multiplication.  Check that the results are
+// in range and evenly spread, and that a range of at most 2^32 values takes a
+// single word when there is no need to draw again.
+
+#include <random>
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+template <class Engine>
+struct counting
+{
+    typedef typename Engine::result_type result_type;
+    static constexpr result_type min() {return Engine::min();}
+    static constexpr result_type max() {return Engine::max();}
+
+    Engine e;
+    long long calls;
+
+    counting() : calls(0) {}
+    result_type operator()() {++calls; return e();}
+};
+
+template <class Engine, class IntType>
+void check_spread(IntType a, IntType b)
+{
+    counting<Engine> g;
+    std::uniform_int_distribution<IntType> d(a, b);
+    const int n = static_cast<int>(b - a) + 1;
+    const int draws = 10000 * n;
+    std::vector<int> count(n);
+    for (int i = 0; i < draws; ++i)
+    {
+        IntType v = d(g);
+        assert(a <= v && v <= b);
+        ++count[v - a];
+    }
+    for (int i = 0; i < n; ++i)
+        assert(count[i] > 9500 && count[i] < 10500);
+    // The range is tiny, so no word was drawn again.
+    assert(g.calls == draws);
+}
+
+template <class Engine, class IntType>
+void check_range(IntType a, IntType b)
+{
+    counting<Engine> g;
+    std::uniform_int_distribution<IntType> d(a, b);
+    IntType lo = b;
+    IntType hi = a;
+    for (int i = 0; i < 100000; ++i)
+    {
+        IntType v = d(g);
+        assert(a <= v && v <= b);
+        lo = std::min(lo, v);
+        hi = std::max(hi, v);
+    }
+    // A quarter of the words are drawn again for ranges of 3 * 2^30 or
+    // 3 * 2^62 values.
+    assert(g.calls > 120000 && g.calls < 150000);
+    const double w = (double(b) - double(a)) / 1000;
+    assert(double(lo) - double(a) < w && double(b) - double(hi) < w);
+}
+
+int main()
+{
+    check_spread<std::mt19937>(0, 6);
+    check_spread<std::mt19937>(-3, 3);
+    check_spread<std::mt19937, long long>(10, 16);
+    check_spread<std::mt19937_64>(0, 6);
+    check_spread<std::mt19937_64, long long>(-1, 5);
+    check_spread<std::mt19937_64, unsigned short>(1, 9);
+
+    check_range<std::mt19937, std::uint32_t>(0, 0xBFFFFFFFu);
+    check_range<std::mt19937, long long>(-1, 0xBFFFFFFEll);
+    check_range<std::mt19937_64, std::uint64_t>(5, 0xC000000000000004ull);
+    check_range<std::mt19937_64, std::int32_t>(INT32_MIN, 0x3FFFFFFF);
+
+    // Ranges over 2^32 from a 32-bit engine take more than one word.
+    counting<std::mt19937> g;
+    std::uniform_int_distribution<long long> d(0, 1ll << 40);
+    for (int i = 0; i < 1000; ++i)
+        assert(d(g) <= 1ll << 40);
+    assert(g.calls >= 2000);
+}
@@ -0,0 +1,92 @@
+//===----------------------------------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is dual licensed under the MIT and the University of Illinois Open
+// Source Licenses. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// <random>
+
+// normal_distribution and exponential_distribution draw float and double
+// values with the Ziggurat method.  Check the probability of falling in each
+// of a few intervals, including those in the wedges at the edge of the layers
+// and in the tail beyond the base layer, and that a normal_distribution read
+// back from a stream goes on with the same values.
+
+#include <random>
+#include <sstream>
+#include <cassert>
+#include <cmath>
+
+template <class D, class G>
+void check_intervals(D d, G g, const double* edges, const double* p, int n)
+{
+    const long N = 4000000;
+    long count[8] = {0};
+    for (long i = 0; i < N; ++i)
+    {
+        const double x = d(g);
+        for (int j = 0; j < n; ++j)
+            if (edges[j] <= x && x < edges[j + 1])
+                ++count[j];
+    }
+    for (int j = 0; j < n; ++j)
+    {
+        // Five standard deviations of the count.
+        const double sd = std::sqrt(N * p[j] * (1 - p[j]));
+        assert(std::abs(count[j] - N * p[j]) < 5 * sd + 1);
+    }
+}
+
+double normal_cdf(double x)
+{
+    return 0.5 * std::erfc(-x / std::sqrt(2.));
+}
+
+int main()
+{
+    {
+        // 3.6541528853610088 is the edge of the base layer.
+        const double e[] = {-1e300, -3.6541528853610088, -1, 0, 0.3, 2.5,
+                            3.6541528853610088, 4.5, 1e300};
+        double p[8];
+        for (int j = 0; j < 8; ++j)
+            p[j] = normal_cdf(e[j + 1]) - normal_cdf(e[j]);
+        check_intervals(std::normal_distribution<>(), std::mt19937(), e, p, 8);
+        check_intervals(std::normal_distribution<>(), std::mt19937_64(), e, p, 8);
+        check_intervals(std::normal_distribution<>(), std::minstd_rand(), e, p, 8);
+    }
+    {
+        // 7.6971174701310497 is the edge of the base layer.
+        const double e[] = {0, 0.01, 0.5, 1, 3, 7.6971174701310497, 9, 1e300};
+        double p[7];
+        for (int j = 0; j < 7; ++j)
+            p[j] = std::exp(-e[j]) - std::exp(-e[j + 1]);
+        check_intervals(std::exponential_distribution<>(), std::mt19937(), e, p, 7);
+        check_intervals(std::exponential_distribution<>(), std::mt19937_64(), e, p, 7);
+        check_intervals(std::exponential_distribution<>(), std::ranlux24(), e, p, 7);
+    }
+    {
+        std::exponential_distribution<float> d(0.5f);
+        std::mt19937 g;
+        for (int i = 0; i < 100000; ++i)
+        {
+            const float x = d(g);
+            assert(x >= 0 && std::isfinite(x));
+        }
+    }
+    {
+        std::normal_distribution<> d(2, 3);
+        std::mt19937 g;
+        d(g);
+        std::stringstream ss;
+        ss << d;
+        std::normal_distribution<> d2;
+        ss >> d2;
+        std::mt19937 g2 = g;
+        for (int i = 0; i < 10; ++i)
+            assert(d(g) == d2(g2));
+    }
+}
@@ -0,0 +1,137 @@
+//===----------------------------------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is dual licensed under the MIT and the University of Illinois Open
+// Source Licenses. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// <random>
+
+// void discard(unsigned long long z);
+
+// linear_congruential_engine, mersenne_twister_engine,
+// subtract_with_carry_engine and discard_block_engine jump ahead instead of
+// stepping when discarding many values.  Check that they land on the state
+// that as many calls of operator() reach, from anywhere in a block of state,
+// and that the jumps of mersenne_twister_engine and
+// subtract_with_carry_engine are right for small counts too.
+
+#include <random>
+#include <sstream>
+#include <cassert>
+
+template <class Engine>
+void check_discard(unsigned long long skip, unsigned long long z)
+{
+    Engine e1;
+    e1.discard(skip);
+    Engine e2 = e1;
+    e1.discard(z);
+    for (unsigned long long i = 0; i < z; ++i)
+        e2();
+    assert(e1 == e2);
+    assert(e1() == e2());
+}
+
+template <class Engine>
+void check_jump(unsigned long long skip, unsigned long long z)
+{
+    Engine e1;
+    e1.discard(skip);
+    Engine e2 = e1;
+    e1.__jump(z);
+    for (unsigned long long i = 0; i < z; ++i)
+        e2();
+    assert(e1 == e2);
+    assert(e1() == e2());
+}
+
+template <class Engine>
+void test_discard(const unsigned long long* z, int n)
+{
+    const unsigned long long skips[] = {0, 1, 23, 700};
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < n; ++j)
+            check_discard<Engine>(skips[i], z[j]);
+}
+
+template <class Engine>
+void test_jump()
+{
+    const unsigned long long skips[] = {0, 1, 5, 24, 700};
+    const unsigned long long z[] = {0, 1, 2, 6, 7, 8, 12, 13, 24, 25, 26, 624,
+                                    625, 1000, 5000};
+    for (int i = 0; i < 5; ++i)
+        for (int j = 0; j < 15; ++j)
+            check_jump<Engine>(skips[i], z[j]);
+}
+
+int main()
+{
+    {
+        const unsigned long long z[] = {0, 1, 15, 16, 17, 1000, 123457};
+        test_discard<std::minstd_rand0>(z, 7);
+        test_discard<std::minstd_rand>(z, 7);
+        test_discard<std::linear_congruential_engine<unsigned long long,
+            6364136223846793005ull, 1442695040888963407ull, 0> >(z, 7);
+        test_discard<std::linear_congruential_engine<unsigned, 1664525, 1013904223, 0> >(z, 7);
+        test_discard<std::linear_congruential_engine<unsigned long long,
+            3037000493ull, 2862933555ull, 18446744073709551557ull> >(z, 7);
+        test_discard<std::linear_congruential_engine<unsigned short, 75, 74, 0> >(z, 7);
+    }
+    {
+        const unsigned long long z[] = {0, 1, 5000, 20000, 123457};
+        test_discard<std::ranlux24_base>(z, 5);
+        test_discard<std::ranlux48_base>(z, 5);
+        test_discard<std::ranlux24>(z, 5);
+        test_discard<std::ranlux48>(z, 5);
+        test_discard<std::discard_block_engine<std::minstd_rand, 7, 3> >(z, 5);
+    }
+    {
+        const unsigned long long z[] = {0, 1, 624, 5000};
+        test_discard<std::mt19937>(z, 4);
+        test_discard<std::mt19937_64>(z, 4);
+        // Far enough for discard to jump.
+        check_discard<std::mt19937>(23, 30000000);
+        check_discard<std::mt19937_64>(23, 30000000);
+    }
+    test_jump<std::mt19937>();
+    test_jump<std::mt19937_64>();
+    test_jump<std::mersenne_twister_engine<unsigned, 16, 7, 3, 5, 0xb5f3, 3, 0x7fff,
+                                           2, 0x3a10, 5, 0x6f00, 7, 27655> >();
+    test_jump<std::ranlux24_base>();
+    test_jump<std::ranlux48_base>();
+    test_jump<std::subtract_with_carry_engine<unsigned, 4, 1, 3> >();
+    test_jump<std::subtract_with_carry_engine<unsigned long long, 64, 3, 7> >();
+    {
+        // The state that every step leaves as it is.
+        std::ranlux24_base e;
+        std::istringstream in("16777215 16777215 16777215 16777215 16777215 "
+                              "16777215 16777215 16777215 16777215 16777215 "
+                              "16777215 16777215 16777215 16777215 16777215 "
+                              "16777215 16777215 16777215 16777215 16777215 "
+                              "16777215 16777215 16777215 16777215 1");
+        in >> e;
+        std::ranlux24_base e2 = e;
+        e.discard(1ull << 40);
+        assert(e == e2);
+    }
+    {
+        std::mt19937 e1;
+        std::mt19937 e2;
+        e1.discard(1ull << 40);
+        e1.discard(~0ull);
+        e2.discard(~0ull);
+        e2.discard(1ull << 40);
+        assert(e1 == e2);
+        std::ranlux48 e3;
+        std::ranlux48 e4;
+        e3.discard(1ull << 40);
+        e3.discard(~0ull);
+        e4.discard(~0ull);
+        e4.discard(1ull << 40);
+        assert(e3 == e4);
+    }
+}
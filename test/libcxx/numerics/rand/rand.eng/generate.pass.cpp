@@ -0,0 +1,68 @@
+//===----------------------------------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is dual licensed under the MIT and the University of Illinois Open
+// Source Licenses. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// <random>
+
+// template <class ForwardIterator>
+//     void __generate(ForwardIterator first, ForwardIterator last);
+
+// Filling a range gives the values of as many calls of operator(), and leaves
+// the engine in the same state, wherever the engine is in its block of state
+// and whatever the length of the range.
+
+#include <random>
+#include <list>
+#include <vector>
+#include <cassert>
+
+template <class Engine>
+void test()
+{
+    const std::size_t skips[] = {0, 1, 23, 24, 312, 623, 700};
+    const std::size_t lengths[] = {0, 1, 11, 24, 25, 311, 312, 624, 625, 2000};
+    for (std::size_t i = 0; i < sizeof(skips) / sizeof(skips[0]); ++i)
+    {
+        for (std::size_t j = 0; j < sizeof(lengths) / sizeof(lengths[0]); ++j)
+        {
+            Engine e1;
+            e1.discard(skips[i]);
+            Engine e2 = e1;
+            std::vector<typename Engine::result_type> v(lengths[j]);
+            std::__generate_random(e1, v.begin(), v.end());
+            for (std::size_t k = 0; k < v.size(); ++k)
+                assert(v[k] == e2());
+            assert(e1 == e2);
+            std::list<unsigned long long> l(lengths[j]);
+            std::__generate_random(e1, l.begin(), l.end());
+            for (std::list<unsigned long long>::iterator k = l.begin(); k != l.end(); ++k)
+                assert(*k == e2());
+            assert(e1 == e2);
+            assert(e1() == e2());
+        }
+    }
+}
+
+int main()
+{
+    static_assert((std::__has_generate<std::mt19937>::value), "");
+    static_assert((std::__has_generate<std::ranlux24>::value), "");
+    static_assert((!std::__has_generate<std::knuth_b>::value), "");
+
+    test<std::minstd_rand0>();
+    test<std::minstd_rand>();
+    test<std::mt19937>();
+    test<std::mt19937_64>();
+    test<std::ranlux24_base>();
+    test<std::ranlux48_base>();
+    test<std::ranlux24>();
+    test<std::ranlux48>();
+    test<std::knuth_b>();
+    test<std::mersenne_twister_engine<unsigned, 16, 7, 7, 5, 0x2b45, 3, 0x7fff,
+                                      2, 0x3a10, 5, 0x6f00, 7, 27655> >();
+}
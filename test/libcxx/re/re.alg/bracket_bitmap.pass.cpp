@@ -0,0 +1,142 @@
+//===----------------------------------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is dual licensed under the MIT and the University of Illinois Open
+// Source Licenses. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// <regex>
+
+// Bracket expressions and class escapes look up the characters below 256 in
+// a bitmap built when the regex is constructed, and a pattern that is one
+// class repeated is searched by scanning for runs of the class.  Check both
+// against the traits and against a pattern that runs the matcher.
+
+#include <regex>
+#include <string>
+#include <cstdlib>
+#include <cctype>
+#include <cassert>
+
+struct class_test
+{
+    const char* pattern;
+    std::regex_constants::syntax_option_type flags;
+    bool (*accepts)(unsigned char);
+};
+
+bool lower_digit_underscore(unsigned char c)
+{
+    return ('a' <= c && c <= 'z') || ('0' <= c && c <= '9') || c == '_';
+}
+bool not_lower(unsigned char c) {return !('a' <= c && c <= 'z');}
+bool a_to_c_icase(unsigned char c)
+{
+    return ('a' <= c && c <= 'c') || ('A' <= c && c <= 'C');
+}
+bool digit(unsigned char c) {return '0' <= c && c <= '9';}
+bool not_digit(unsigned char c) {return !digit(c);}
+bool word(unsigned char c)
+{
+    return c < 128 && (std::isalnum(c) || c == '_');
+}
+bool not_word(unsigned char c) {return !word(c);}
+bool space(unsigned char c) {return c < 128 && std::isspace(c);}
+bool not_space(unsigned char c) {return !space(c);}
+bool punct_or_x(unsigned char c) {return (c < 128 && std::ispunct(c)) || c == 'x';}
+bool high(unsigned char c) {return c >= 0xE0;}
+
+void check_classes()
+{
+    const std::regex_constants::syntax_option_type E = std::regex_constants::ECMAScript;
+    const class_test tests[] = {
+        {"[a-z0-9_]", E, lower_digit_underscore},
+        {"[^a-z]", E, not_lower},
+        {"[a-c]", E | std::regex_constants::icase, a_to_c_icase},
+        {"[^[:lower:]]", std::regex_constants::extended, not_lower},
+        {"\\d", E, digit},
+        {"\\D", E, not_digit},
+        {"\\w", E, word},
+        {"\\W", E, not_word},
+        {"\\s", E, space},
+        {"\\S", E, not_space},
+        {"[[:punct:]x]", std::regex_constants::basic, punct_or_x},
+        {"[\\xE0-\\xFF]", E, high},
+    };
+    for (unsigned t = 0; t < sizeof(tests) / sizeof(tests[0]); ++t)
+    {
+        const std::regex re(tests[t].pattern, tests[t].flags);
+        for (unsigned c = 0; c < 256; ++c)
+        {
+            const std::string s(1, static_cast<char>(c));
+            assert(std::regex_match(s, re) == tests[t].accepts(c));
+        }
+    }
+    // Characters above 255 are still tested against the lists.
+    const std::wregex w(L"[^a-z]");
+    assert(std::regex_match(std::wstring(1, L'\x100'), w));
+    assert(!std::regex_match(std::wstring(1, L'q'), w));
+    const std::wregex wd(L"[\\u0100-\\u01FF]");
+    assert(std::regex_match(std::wstring(1, L'\x150'), wd));
+    assert(!std::regex_match(std::wstring(1, L'\x50'), wd));
+}
+
+// The negative lookahead of something that can never match does not change
+// what the pattern matches, but keeps it from being searched as a run.
+void check_run(const std::string& pattern, const std::string& s,
+               std::regex_constants::match_flag_type flags)
+{
+    const std::regex fast(pattern);
+    const std::regex slow(pattern + "(?!\\b\\B)");
+    std::smatch mf, ms;
+    bool f = std::regex_search(s, mf, fast, flags);
+    bool sl = std::regex_search(s, ms, slow, flags);
+    assert(f == sl);
+    if (f)
+    {
+        assert(mf.position(0) == ms.position(0));
+        assert(mf.length(0) == ms.length(0));
+        assert(mf.prefix() == ms.prefix());
+        assert(mf.suffix() == ms.suffix());
+    }
+    assert(std::regex_match(s, fast) == std::regex_match(s, slow));
+}
+
+void check_runs()
+{
+    const char* patterns[] = {
+        "[a-z0-9_]+", "[a-z]{3,}", "\\w{2,4}", "a+", "[^ ]+", "[[:alpha:]]{2}",
+        "[a-z]+?", "[ab9]{20,}", "[a-z\\x80-\\xFF]+", "[acegikmoqsuwy_-]+"};
+    const char alphabet[] = "abcxyz_9- A\xE9";
+    std::srand(1);
+    for (int i = 0; i < 2000; ++i)
+    {
+        std::string s(std::rand() % 80, ' ');
+        for (std::string::size_type j = 0; j < s.size(); ++j)
+            s[j] = alphabet[std::rand() % (sizeof(alphabet) - 1)];
+        for (unsigned p = 0; p < sizeof(patterns) / sizeof(patterns[0]); ++p)
+        {
+            check_run(patterns[p], s, std::regex_constants::match_default);
+            check_run(patterns[p], s, std::regex_constants::match_continuous);
+        }
+    }
+    // A long run goes past the characters tested one at a time.
+    const std::string s = "--" + std::string(100, 'a') + "b1_" + std::string(40, '-');
+    std::smatch m;
+    assert(std::regex_search(s, m, std::regex("[a-z0-9_]+")));
+    assert(m.position(0) == 2 && m.length(0) == 103);
+    assert(std::regex_search(s, m, std::regex("[a-z]{3,5}")));
+    assert(m.position(0) == 2 && m.length(0) == 5);
+    assert(!std::regex_match(s, std::regex("[a-z0-9_-]{3,5}")));
+    assert(std::regex_match(s, std::regex("[a-z0-9_-]+")));
+    assert(std::regex_search(s, m, std::regex("[a-z]+", std::regex_constants::extended)));
+    assert(m.position(0) == 2 && m.length(0) == 101);
+}
+
+int main()
+{
+    check_classes();
+    check_runs();
+}
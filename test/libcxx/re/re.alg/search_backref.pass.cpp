@@ -0,0 +1,146 @@
+//===----------------------------------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is dual licensed under the MIT and the University of Illinois Open
+// Source Licenses. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: libcpp-no-exceptions
+// <regex>
+
+// ECMAScript patterns with back references are run by backtracking over the
+// program of the NFA instead of over the nodes.  Check that it finds the same
+// matches and subexpressions as the node matcher, and that it gives up with
+// the same error on a pattern that takes exponential time.
+
+#include <regex>
+#include <string>
+#include <cassert>
+
+template <class CharT>
+std::basic_string<CharT> widen(const char* s)
+{
+    std::basic_string<CharT> r;
+    for (; *s; ++s)
+        r += CharT(static_cast<unsigned char>(*s));
+    return r;
+}
+
+template <class CharT>
+void compare(const std::match_results<const CharT*>& m,
+             const std::match_results<const CharT*>& mref)
+{
+    assert(m.size() == mref.size());
+    for (std::size_t j = 0; j < m.size(); ++j)
+    {
+        assert(m[j].matched == mref[j].matched);
+        if (m[j].matched)
+            assert(m.position(j) == mref.position(j) &&
+                   m.length(j) == mref.length(j));
+    }
+}
+
+template <class CharT>
+void check(const char* pattern, const char* subject,
+           std::regex_constants::syntax_option_type f)
+{
+    typedef std::basic_regex<CharT> R;
+    const std::basic_string<CharT> s = widen<CharT>(subject);
+    R re(widen<CharT>(pattern), f);
+    // A lookahead that always holds keeps the pattern on the node matcher.
+    R ref(widen<CharT>("(?!\\b\\B)(?:") + widen<CharT>(pattern) +
+          widen<CharT>(")"), f);
+    const std::regex_constants::match_flag_type flags[] = {
+        std::regex_constants::match_default,
+        std::regex_constants::match_not_bol | std::regex_constants::match_not_eol,
+        std::regex_constants::match_not_bow | std::regex_constants::match_not_eow,
+        std::regex_constants::match_continuous,
+        std::regex_constants::match_prev_avail,
+        std::regex_constants::match_not_null
+    };
+    for (std::size_t i = 0; i < sizeof(flags) / sizeof(flags[0]); ++i)
+    {
+        for (std::size_t start = 0; start <= s.size(); ++start)
+        {
+            if (start == 0 && flags[i] == std::regex_constants::match_prev_avail)
+                continue;
+            std::match_results<const CharT*> m, mref;
+            bool r = std::regex_search(s.data() + start, s.data() + s.size(),
+                                       m, re, flags[i]);
+            assert(r == std::regex_search(s.data() + start, s.data() + s.size(),
+                                          mref, ref, flags[i]));
+            if (r)
+                compare(m, mref);
+        }
+        std::match_results<const CharT*> m, mref;
+        bool r = std::regex_match(s.data(), s.data() + s.size(), m, re, flags[i]);
+        assert(r == std::regex_match(s.data(), s.data() + s.size(), mref, ref,
+                                     flags[i]));
+        if (r)
+            compare(m, mref);
+    }
+}
+
+template <class CharT>
+void test()
+{
+    const char* subjects[] = {
+        "",
+        "aa",
+        "abab",
+        "aaaaab",
+        "abcabc abc",
+        "foo foo bar",
+        "x1y11z111",
+        "_a__a_"
+    };
+    const char* patterns[] = {
+        "(a)\\1",
+        "(\\w+) \\1",
+        "(a|b)\\1+",
+        "(a*)b\\1",
+        "((a)|b)\\2",
+        "(?:(a)|b)\\1",
+        "(a+?)\\1$",
+        "^(\\w)\\w*\\1$",
+        "(a)(b)?\\2",
+        "\\b(\\w)\\1\\b",
+        "\\B(\\w)\\1",
+        "(ab|a)\\1c?",
+        "((a)\\2)+",
+        "(\\w)(?:x|\\1)*",
+        "(1)\\1{1,2}",
+        "(.)\\1*?b",
+        "(abc)\\1?"
+    };
+    for (std::size_t i = 0; i < sizeof(patterns) / sizeof(patterns[0]); ++i)
+    {
+        for (std::size_t j = 0; j < sizeof(subjects) / sizeof(subjects[0]); ++j)
+        {
+            check<CharT>(patterns[i], subjects[j], std::regex_constants::ECMAScript);
+            check<CharT>(patterns[i], subjects[j], std::regex_constants::ECMAScript |
+                                                   std::regex_constants::icase);
+        }
+    }
+}
+
+int main()
+{
+    test<char>();
+    test<wchar_t>();
+
+    {
+        std::string s(100, 'a');
+        try
+        {
+            std::regex_search(s, std::regex("(a?)(?:a|a)*\\1b"));
+            assert(false);
+        }
+        catch (const std::regex_error& e)
+        {
+            assert(e.code() == std::regex_constants::error_complexity);
+        }
+    }
+}
@@ -0,0 +1,86 @@
+//===----------------------------------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is dual licensed under the MIT and the University of Illinois Open
+// Source Licenses. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++98, c++03
+// XFAIL: availability
+
+// <regex>
+
+// The per-thread caches of matching live in slots owned by the dylib.  A
+// search leaves alone a cache that code built against another layout put in
+// its slot, and uses one of its own.
+
+#include <regex>
+#include <string>
+#include <cassert>
+
+struct foreign_cache
+    : public std::__regex_cache_base
+{
+    unsigned canary[64];
+
+    foreign_cache(unsigned v, std::size_t n)
+        : std::__regex_cache_base(v, n)
+    {
+        for (unsigned i = 0; i < 64; ++i)
+            canary[i] = i * 2654435761u;
+    }
+
+    bool intact() const
+    {
+        for (unsigned i = 0; i < 64; ++i)
+            if (canary[i] != i * 2654435761u)
+                return false;
+        return true;
+    }
+};
+
+void search()
+{
+    // The lookahead takes the cache of lookaheads.
+    const std::regex re("(\\w+)@(?=\\w+\\.com)(\\w+)\\.com");
+    const std::string s = "mail alice@example.com now";
+    std::smatch m;
+    assert(std::regex_search(s, m, re));
+    assert(m.str(1) == "alice");
+    assert(m.str(2) == "example");
+    const std::string t = "bob@host.com";
+    assert(std::regex_match(t, m, re));
+    assert(m.str(1) == "bob");
+}
+
+int main()
+{
+    std::__regex_cache_base** outer = std::__regex_thread_cache(0);
+    std::__regex_cache_base** inner = std::__regex_thread_cache(2);
+    if (outer == nullptr || inner == nullptr)
+        return 0;
+    assert(*outer == nullptr && *inner == nullptr);
+    // Another version, and the same version with another size.
+    foreign_cache* f1 = new foreign_cache(std::__regex_cache<char>::__version + 1,
+                                          sizeof(std::__regex_cache<char>));
+    foreign_cache* f2 = new foreign_cache(std::__regex_cache<char>::__version,
+                                          sizeof(foreign_cache));
+    *outer = f1;
+    *inner = f2;
+    search();
+    search();
+    assert(*outer == f1 && *inner == f2);
+    assert(f1->intact() && f2->intact());
+    // With the slots empty again, searches fill them with their own caches.
+    delete f1;
+    delete f2;
+    *outer = nullptr;
+    *inner = nullptr;
+    search();
+    assert(*outer != nullptr && *inner != nullptr);
+    assert((*inner)->__version_ == std::__regex_cache<char>::__version);
+    assert((*outer)->__version_ == std::__regex_cache<char>::__version);
+    assert((*outer)->__size_ == sizeof(std::__regex_cache<char>));
+}
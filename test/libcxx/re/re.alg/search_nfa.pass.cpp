@@ -0,0 +1,196 @@
+//===----------------------------------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is dual licensed under the MIT and the University of Illinois Open
+// Source Licenses. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// <regex>
+
+// Patterns without back references or lookaheads are run as an NFA, and
+// regex_match follows a single thread when the pattern is one-pass.  Check
+// that they find the same matches and subexpressions as the backtracking
+// matcher, and that they take linear time on patterns that make the
+// backtracking matcher give up.
+
+#include <regex>
+#include <string>
+#include <cassert>
+
+template <class CharT>
+std::basic_string<CharT> widen(const char* s)
+{
+    std::basic_string<CharT> r;
+    for (; *s; ++s)
+        r += CharT(static_cast<unsigned char>(*s));
+    return r;
+}
+
+template <class CharT>
+void compare(const std::match_results<const CharT*>& m,
+             const std::match_results<const CharT*>& mref, std::size_t skip)
+{
+    assert(m.position(0) == mref.position(0) && m.length(0) == mref.length(0));
+    for (std::size_t j = 1; j < m.size(); ++j)
+    {
+        assert(m[j].matched == mref[j + skip].matched);
+        if (m[j].matched)
+            assert(m.position(j) == mref.position(j + skip) &&
+                   m.length(j) == mref.length(j + skip));
+    }
+}
+
+template <class CharT>
+void check(const char* pattern, const char* subject,
+           std::regex_constants::syntax_option_type f)
+{
+    typedef std::basic_regex<CharT> R;
+    const std::basic_string<CharT> s = widen<CharT>(subject);
+    R re(widen<CharT>(pattern), f);
+    // A lookahead that always holds makes an ECMAScript pattern backtrack,
+    // and so does a loop whose body only matches the empty string for a
+    // POSIX one.
+    const std::size_t posix = (f & std::regex_constants::extended) ? 1 : 0;
+    R ref = posix ?
+        R(widen<CharT>("(") + widen<CharT>(pattern) + widen<CharT>(")(a{0})*"),
+          f & ~std::regex_constants::nosubs) :
+        R(widen<CharT>("(?!\\b\\B)(?:") + widen<CharT>(pattern) +
+          widen<CharT>(")"), f);
+    const std::regex_constants::match_flag_type flags[] = {
+        std::regex_constants::match_default,
+        std::regex_constants::match_not_bol | std::regex_constants::match_not_eol,
+        std::regex_constants::match_not_bow | std::regex_constants::match_not_eow,
+        std::regex_constants::match_continuous,
+        std::regex_constants::match_prev_avail,
+        std::regex_constants::match_not_null
+    };
+    const std::size_t skip = ref.mark_count() - re.mark_count() - posix;
+    for (std::size_t i = 0; i < sizeof(flags) / sizeof(flags[0]); ++i)
+    {
+        for (std::size_t start = 0; start <= s.size(); ++start)
+        {
+            if (start == 0 && flags[i] == std::regex_constants::match_prev_avail)
+                continue;
+            std::match_results<const CharT*> m, mref;
+            bool r = std::regex_search(s.data() + start, s.data() + s.size(),
+                                       m, re, flags[i]);
+            bool rref = std::regex_search(s.data() + start, s.data() + s.size(),
+                                          mref, ref, flags[i]);
+            assert(r == rref);
+            if (!r)
+                continue;
+            assert(m.size() + skip + posix == mref.size());
+            compare(m, mref, skip);
+        }
+        std::match_results<const CharT*> m, mref;
+        bool r = std::regex_match(s.data(), s.data() + s.size(), m, re, flags[i]);
+        assert(r == std::regex_match(s.data(), s.data() + s.size(), mref, ref,
+                                     flags[i]));
+        if (r)
+            compare(m, mref, skip);
+    }
+}
+
+template <class CharT>
+void test()
+{
+    const char* subjects[] = {
+        "",
+        "a",
+        "ab",
+        "abcd",
+        "aaaaab",
+        "abababab",
+        "foo bar_baz  qux",
+        "x1y22z333",
+        "Hello, World\nline 2",
+        "2017-10-04x",
+        "ab 12"
+    };
+    const char* ecma[] = {
+        "a|ab",
+        "(a|ab)(c|bcd)(d*)",
+        "(a*)(a*)b",
+        "(a*?)(a*)b",
+        "(a+?)(b?)",
+        "((a)|b)+",
+        "(a|(b))+c?",
+        "(?:(a)|(b)){2,3}",
+        "(ab){1,2}?",
+        "a{2}|b{0,2}",
+        "[a-c]+d|[^a-c ]+",
+        "\\b\\w+\\b",
+        "\\B\\w",
+        "^\\w+|\\d+$",
+        "(\\d)(\\d)?",
+        "\\s+(\\S+)",
+        "o.",
+        "(.)",
+        "[[:alpha:]]+",
+        "(?:ab|a)(?:bab)*",
+        "(x)?a",
+        "b*",
+        "(\\d+)-(\\d+)-(\\w+)",
+        "^(\\w+)\\s(\\d*)$",
+        "(?:(a)|(b))*c?",
+        "(a)?(b)?(\\w)\\b"
+    };
+    for (std::size_t i = 0; i < sizeof(ecma) / sizeof(ecma[0]); ++i)
+    {
+        for (std::size_t j = 0; j < sizeof(subjects) / sizeof(subjects[0]); ++j)
+        {
+            check<CharT>(ecma[i], subjects[j], std::regex_constants::ECMAScript);
+            check<CharT>(ecma[i], subjects[j], std::regex_constants::ECMAScript |
+                                               std::regex_constants::icase);
+            check<CharT>(ecma[i], subjects[j], std::regex_constants::ECMAScript |
+                                               std::regex_constants::nosubs);
+        }
+    }
+    const char* posix[] = {
+        "a|ab",
+        "(a|ab)(c|bcd)(d*)",
+        "a*b|ab*",
+        "[[:alnum:]_]+",
+        "o.|x[0-9]{1,2}",
+        "((a)|b)+",
+        "(a*)(ab|b)",
+        "([0-9]+)-([0-9]+)-([[:alnum:]]+)",
+        "(x)?(.)([0-9]*)"
+    };
+    for (std::size_t i = 0; i < sizeof(posix) / sizeof(posix[0]); ++i)
+    {
+        for (std::size_t j = 0; j < sizeof(subjects) / sizeof(subjects[0]); ++j)
+        {
+            check<CharT>(posix[i], subjects[j], std::regex_constants::extended);
+            check<CharT>(posix[i], subjects[j], std::regex_constants::extended |
+                                                std::regex_constants::nosubs);
+        }
+    }
+}
+
+int main()
+{
+    test<char>();
+    test<wchar_t>();
+
+    // The backtracking matcher gives up on these.
+    {
+        std::string s(10000, 'a');
+        assert(!std::regex_search(s, std::regex("(a|aa)*b")));
+        assert(!std::regex_match(s, std::regex("(a+)+b")));
+        const std::string sb = s + "b";
+        std::smatch m;
+        assert(std::regex_match(sb, m, std::regex("(a|aa)*b")));
+        assert(m.length(1) == 1);
+        std::string p;
+        for (int i = 0; i < 30; ++i)
+            p += "a?";
+        for (int i = 0; i < 30; ++i)
+            p += "a";
+        assert(std::regex_match(std::string(30, 'a'), std::regex(p)));
+        assert(std::regex_match(std::string(30, 'a'),
+                                std::regex(p, std::regex_constants::extended)));
+    }
+}
@@ -0,0 +1,187 @@
+//===----------------------------------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is dual licensed under the MIT and the University of Illinois Open
+// Source Licenses. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++98, c++03
+// XFAIL: availability
+
+// <regex>
+
+// Matching keeps its scratch space in a per-thread cache, so that searching
+// again with the same kind of regex and results does not allocate.  A search
+// run from inside another one, and searches on other threads, get their own.
+
+#include <regex>
+#include <string>
+#include <cassert>
+#ifndef _LIBCPP_HAS_NO_THREADS
+#include <thread>
+#endif
+
+#include "count_new.hpp"
+
+template <class F>
+void check_no_alloc(F f)
+{
+    f();
+    globalMemCounter.reset();
+    f();
+    f();
+    assert(globalMemCounter.checkNewCalledEq(0));
+}
+
+struct search_string
+{
+    const std::regex& re;
+    const std::string& s;
+    std::smatch& m;
+    void operator()() const
+    {
+        assert(std::regex_search(s, m, re));
+        assert(std::regex_search(s, re));
+    }
+};
+
+struct match_string
+{
+    const std::regex& re;
+    const std::string& s;
+    std::smatch& m;
+    void operator()() const
+    {
+        assert(std::regex_match(s, m, re));
+        assert(std::regex_match(s, re));
+    }
+};
+
+struct search_pointer
+{
+    const std::wregex& re;
+    const wchar_t* s;
+    std::wcmatch& m;
+    void operator()() const
+    {
+        assert(!std::regex_match(s, m, re));
+        assert(std::regex_search(s, m, re));
+    }
+};
+
+struct iterate
+{
+    const std::regex& re;
+    const std::string& s;
+    std::sregex_iterator& i;
+    void operator()() const
+    {
+        i = std::sregex_iterator(s.begin(), s.end(), re);
+        int n = 0;
+        for (std::sregex_iterator e; i != e; ++i)
+            ++n;
+        assert(n == 2);
+    }
+};
+
+// Searches from inside the traits of another search.
+struct nested_traits
+    : std::regex_traits<char>
+{
+    bool isctype(char c, char_class_type f) const
+    {
+        std::string s(1, c);
+        std::smatch m;
+        assert(std::regex_search(s, m, std::regex("(.?)\\1?")));
+        assert(m[1] == s || c == '\n' || c == '\r');
+        return std::regex_traits<char>::isctype(c, f);
+    }
+};
+
+#ifndef _LIBCPP_HAS_NO_THREADS
+void search_on_thread(int n)
+{
+    const std::regex re("(\\d+)-(\\d+)");
+    const std::string s = "id " + std::to_string(n) + "-" + std::to_string(n + 1);
+    std::smatch m;
+    for (int i = 0; i < 1000; ++i)
+    {
+        assert(std::regex_search(s, m, re));
+        assert(m[1] == std::to_string(n) && m[2] == std::to_string(n + 1));
+    }
+}
+#endif
+
+int main()
+{
+    const std::string s = "2017-10-04 12:00:03 ERROR disk is full";
+    std::smatch m;
+    {
+        std::regex re("(\\d+):(\\d+)(:\\d+)? (\\w+)");
+        search_string f = {re, s, m};
+        check_no_alloc(f);
+        assert(m[4] == "ERROR");
+    }
+    {
+        std::regex re("(\\d)\\1");
+        search_string f = {re, s, m};
+        check_no_alloc(f);
+        assert(m[0] == "00");
+    }
+    {
+        std::regex re("([0-9]+)(-|:)([0-9]+)", std::regex_constants::extended);
+        search_string f = {re, s, m};
+        check_no_alloc(f);
+        assert(m[0] == "2017-10");
+    }
+    {
+        std::regex re("(?=.*ERROR)(\\S+) (?!ERROR)(.*)");
+        match_string f = {re, s, m};
+        check_no_alloc(f);
+        assert(m[1] == "2017-10-04");
+    }
+    {
+        std::regex re("([^ ]+ )+(.*)", std::regex_constants::extended);
+        match_string f = {re, s, m};
+        check_no_alloc(f);
+        assert(m[2] == "full");
+    }
+    {
+        std::wregex re(L"[A-Z]+");
+        std::wcmatch wm;
+        search_pointer f = {re, L"2017-10-04 ERROR", wm};
+        check_no_alloc(f);
+        assert(wm.position(0) == 11);
+    }
+    {
+        std::regex re("\\d+:");
+        std::sregex_iterator i;
+        iterate f = {re, s, i};
+        f();
+        globalMemCounter.reset();
+        f();
+        // One allocation to set up the results of the new iterator.
+        assert(globalMemCounter.checkNewCalledEq(1));
+    }
+    {
+        std::basic_regex<char, nested_traits> re("[[:alpha:]]+(\\d)");
+        std::smatch m2;
+        assert(std::regex_search(s, m2, re) == false);
+        // The back reference makes it backtrack, which asks the traits.
+        std::basic_regex<char, nested_traits> re2("([[:alpha:]]+) \\1?([[:alpha:]]+)");
+        assert(std::regex_search(s, m2, re2));
+        assert(m2[1] == "ERROR" && m2[2] == "disk");
+    }
+#ifndef _LIBCPP_HAS_NO_THREADS
+    {
+        std::thread t[4];
+        for (int i = 0; i < 4; ++i)
+            t[i] = std::thread(search_on_thread, 10 * i);
+        search_on_thread(100);
+        for (int i = 0; i < 4; ++i)
+            t[i].join();
+    }
+#endif
+}
@@ -0,0 +1,186 @@
+//===----------------------------------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is dual licensed under the MIT and the University of Illinois Open
+// Source Licenses. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// <regex>
+
+// regex_search skips the positions where the literal prefix, the possible
+// first characters, the required characters or a leading ^ rule out a match.
+// Check that it finds the same matches as a pattern that starts with an empty
+// alternation, which defeats that analysis.
+
+#include <regex>
+#include <string>
+#include <cstring>
+#include <cassert>
+
+template <class CharT>
+std::basic_string<CharT> widen(const char* s)
+{
+    std::basic_string<CharT> r;
+    for (; *s; ++s)
+        r += CharT(static_cast<unsigned char>(*s));
+    return r;
+}
+
+template <class CharT>
+void check(const char* pattern, const char* subject,
+           std::regex_constants::syntax_option_type f =
+               std::regex_constants::ECMAScript)
+{
+    typedef std::basic_regex<CharT> R;
+    const std::basic_string<CharT> p = widen<CharT>(pattern);
+    const std::basic_string<CharT> s = widen<CharT>(subject);
+    R re(p, f);
+    R ref(widen<CharT>("(?:|)") + p, f);
+    const std::regex_constants::match_flag_type flags[] = {
+        std::regex_constants::match_default,
+        std::regex_constants::match_not_bol,
+        std::regex_constants::match_continuous,
+        std::regex_constants::match_prev_avail,
+        std::regex_constants::match_not_null
+    };
+    for (std::size_t i = 0; i < sizeof(flags) / sizeof(flags[0]); ++i)
+    {
+        for (std::size_t start = 0; start <= s.size(); ++start)
+        {
+            if (start == 0 && flags[i] == std::regex_constants::match_prev_avail)
+                continue;
+            std::match_results<const CharT*> m, mref;
+            bool r = std::regex_search(s.data() + start, s.data() + s.size(),
+                                       m, re, flags[i]);
+            bool rref = std::regex_search(s.data() + start, s.data() + s.size(),
+                                          mref, ref, flags[i]);
+            assert(r == rref);
+            assert(m.size() == mref.size());
+            for (std::size_t j = 0; j < m.size(); ++j)
+            {
+                assert(m[j].matched == mref[j].matched);
+                if (m[j].matched)
+                    assert(m.position(j) == mref.position(j) &&
+                           m.length(j) == mref.length(j));
+            }
+            assert(std::regex_search(s.data() + start, s.data() + s.size(),
+                                     re, flags[i]) == r);
+        }
+    }
+}
+
+template <class CharT>
+void test()
+{
+    const char* subjects[] = {
+        "",
+        "a",
+        "error",
+        "an error occurred: ERROR 42, Error 7",
+        "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxerrorxxx",
+        "errorerror",
+        "err",
+        "foo bar baz foobar",
+        "\xE9t\xE9 \xE9tait",
+        "line one\nline two\nerror three"
+    };
+    const char* patterns[] = {
+        "error",
+        "err(or)?",
+        "e(r+)or",
+        "[eE]rror",
+        "[^a-z ]",
+        "\\d+",
+        "(foo|bar)baz",
+        "(foo|bar) baz",
+        "foo|ba[rz]",
+        "a*error",
+        "x*e",
+        "^error",
+        "^(an|line) ",
+        "error$",
+        "\\berror\\b",
+        "(?=e)err",
+        "(?!e)rr",
+        "[a-z]+ (error|two)",
+        "o.e",
+        "\\w+: ERROR \\d+",
+        "(e)rr\\1?",
+        "(x{0}e)rror",
+        "x{0}",
+        "\xE9t",
+        "t\xE9",
+        ".",
+        "a?",
+        "(a|)(b|)(c|)(d|)(e|)(f|)(g|)(h|)(i|)(j|)(k|)(l|)(m|)r"
+    };
+    for (std::size_t i = 0; i < sizeof(patterns) / sizeof(patterns[0]); ++i)
+    {
+        for (std::size_t j = 0; j < sizeof(subjects) / sizeof(subjects[0]); ++j)
+        {
+            check<CharT>(patterns[i], subjects[j]);
+            check<CharT>(patterns[i], subjects[j], std::regex_constants::icase);
+            if (std::strstr(patterns[i], "\\1") == 0)
+                check<CharT>(patterns[i], subjects[j],
+                             std::regex_constants::ECMAScript |
+                             std::regex_constants::nosubs);
+        }
+    }
+}
+
+int main()
+{
+    test<char>();
+    test<wchar_t>();
+
+    // POSIX grammars take the same shortcuts.
+    {
+        std::regex re("err(or)*", std::regex_constants::extended);
+        std::cmatch m;
+        assert(std::regex_search("an error", m, re));
+        assert(m.position(0) == 3 && m.length(0) == 5);
+        assert(!std::regex_search("no match here", m, re));
+    }
+    {
+        std::regex re("^ab*c", std::regex_constants::basic);
+        std::cmatch m;
+        assert(std::regex_search("abbbc", m, re));
+        assert(!std::regex_search("xabbbc", m, re));
+    }
+    {
+        std::regex re("b\nab", std::regex_constants::grep);
+        std::cmatch m;
+        assert(std::regex_search("xxab", m, re));
+        assert(m.position(0) == 2 && m.length(0) == 2);
+    }
+
+    // A default constructed regex matches nothing.
+    {
+        std::regex re;
+        std::cmatch m;
+        assert(!std::regex_search("abc", m, re));
+        assert(m.size() == 0);
+    }
+
+    // regex_iterator keeps finding matches after the first one.
+    {
+        std::string s = "error; error; ok; error";
+        std::regex re("error");
+        std::sregex_iterator i(s.begin(), s.end(), re), e;
+        int n = 0;
+        for (; i != e; ++i)
+            ++n;
+        assert(n == 3);
+    }
+    {
+        std::string s = "error; error; ok; error";
+        std::regex re("^error");
+        std::sregex_iterator i(s.begin(), s.end(), re), e;
+        int n = 0;
+        for (; i != e; ++i)
+            ++n;
+        assert(n == 1);
+    }
+}
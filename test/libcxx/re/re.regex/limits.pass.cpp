@@ -0,0 +1,129 @@
+//===----------------------------------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is dual licensed under the MIT and the University of Illinois Open
+// Source Licenses. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: libcpp-no-exceptions
+
+// <regex>
+
+// Patterns nested deeper than _LIBCPP_REGEX_MAX_DEPTH, and matches that need
+// more than _LIBCPP_REGEX_STACK_LIMIT bytes of backtracking state, fail with
+// error_stack.  Long patterns are built and destroyed without recursing.
+
+#define _LIBCPP_REGEX_MAX_DEPTH 16
+#define _LIBCPP_REGEX_STACK_LIMIT (1 << 20)
+
+#include <regex>
+#include <string>
+#include <cassert>
+
+std::string nest(const char* open, const char* close, int n)
+{
+    std::string s;
+    for (int i = 0; i < n; ++i)
+        s += open;
+    s += "a";
+    for (int i = 0; i < n; ++i)
+        s += close;
+    return s;
+}
+
+bool fails_with_stack(const std::string& p,
+                      std::regex_constants::syntax_option_type f =
+                          std::regex_constants::ECMAScript)
+{
+    try
+    {
+        std::regex re(p, f);
+    }
+    catch (const std::regex_error& e)
+    {
+        return e.code() == std::regex_constants::error_stack;
+    }
+    return false;
+}
+
+int main()
+{
+    // Nesting.
+    {
+        const std::regex_constants::syntax_option_type ecma =
+            std::regex_constants::ECMAScript;
+        assert(std::regex_match("a", std::regex(nest("(", ")", 16))));
+        assert(fails_with_stack(nest("(", ")", 17)));
+        assert(std::regex_match("a", std::regex(nest("(?:", ")", 16))));
+        assert(fails_with_stack(nest("(?:", ")", 17)));
+        assert(std::regex_match("a", std::regex(nest("(?=", ")", 15) + "a")));
+        assert(fails_with_stack(nest("(?=", ")", 17) + "a"));
+        assert(fails_with_stack(nest("(?!(", "))", 9) + "a", ecma));
+        assert(std::regex_match("a", std::regex(nest("(", ")", 16),
+                                                std::regex_constants::extended)));
+        assert(fails_with_stack(nest("(", ")", 17),
+                                std::regex_constants::extended));
+        assert(fails_with_stack(nest("(", ")", 17), std::regex_constants::awk));
+        assert(fails_with_stack(nest("(", ")", 17), std::regex_constants::egrep));
+        assert(std::regex_match("a", std::regex(nest("\\(", "\\)", 16),
+                                                std::regex_constants::basic)));
+        assert(fails_with_stack(nest("\\(", "\\)", 17),
+                                std::regex_constants::basic));
+        assert(fails_with_stack(nest("\\(", "\\)", 17),
+                                std::regex_constants::grep));
+        // Groups one after another do not nest.
+        std::string p;
+        for (int i = 0; i < 100; ++i)
+            p += nest("(", ")", 16);
+        assert(std::regex_match(std::string(100, 'a'), std::regex(p)));
+    }
+
+    // Long patterns.
+    {
+        const std::string s(1000000, 'a');
+        std::regex re(s);
+        assert(std::regex_match(s, re));
+        assert(!std::regex_search(s.substr(1), re));
+    }
+    {
+        std::string p;
+        for (int i = 0; i < 100000; ++i)
+        {
+            if (i != 0)
+                p += '|';
+            p += 'a' + i % 26;
+            p += 'a' + i / 26 % 26;
+            p += 'a' + i / 676 % 26;
+            p += 'a' + i / 17576 % 26;
+        }
+        std::regex re(p);
+        // Trying each alternative in turn keeps a state for each one left.
+        try
+        {
+            std::regex_search("xxx abcd", re);
+            assert(false);
+        }
+        catch (const std::regex_error& e)
+        {
+            assert(e.code() == std::regex_constants::error_stack);
+        }
+    }
+
+    // Backtracking state.
+    {
+        std::regex re("(a*)\\1b");
+        assert(std::regex_match("aaaab", re));
+        const std::string s(100000, 'a');
+        try
+        {
+            std::regex_search(s, re);
+            assert(false);
+        }
+        catch (const std::regex_error& e)
+        {
+            assert(e.code() == std::regex_constants::error_stack);
+        }
+    }
+}
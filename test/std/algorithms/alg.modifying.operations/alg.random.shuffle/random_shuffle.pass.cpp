@@ -23,8 +23,8 @@
 int main()
 {
     int ia[] = {1, 2, 3, 4};
-    int ia1[] = {1, 4, 3, 2};
-    int ia2[] = {4, 1, 2, 3};
+    int ia1[] = {4, 2, 1, 3};
+    int ia2[] = {3, 2, 4, 1};
     const unsigned sa = sizeof(ia)/sizeof(ia[0]);
     std::random_shuffle(ia, ia+sa);
     LIBCPP_ASSERT(std::equal(ia, ia+sa, ia1));
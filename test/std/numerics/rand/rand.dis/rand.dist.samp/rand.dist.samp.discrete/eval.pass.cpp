@@ -73,7 +73,7 @@ int main()
         }
         std::vector<double> prob = d.probabilities();
         for (int i = 0; i <= d.max(); ++i)
-            assert(std::abs((double)u[i]/N - prob[i]) / prob[i] < 0.001);
+            assert(std::abs((double)u[i]/N - prob[i]) / prob[i] < 0.005);
     }
     {
         typedef std::discrete_distribution<> D;
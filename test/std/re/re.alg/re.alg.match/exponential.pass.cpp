@@ -27,11 +27,21 @@ int main() {
   for (std::regex_constants::syntax_option_type op :
        {std::regex::ECMAScript, std::regex::extended, std::regex::egrep,
         std::regex::awk}) {
+    // Patterns that can run as an NFA match in linear time.
+    assert(std::regex_match(
+        "aaaaaaaaaaaaaaaaaaaa",
+        std::regex(
+            "a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?aaaaaaaaaaaaaaaaaaaa",
+            op)));
+    // A lookahead, or a loop whose body only matches the empty string,
+    // needs the backtracking matcher.
     try {
       std::regex_match(
           "aaaaaaaaaaaaaaaaaaaa",
           std::regex(
-              "a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?aaaaaaaaaaaaaaaaaaaa",
+              op == std::regex::ECMAScript ?
+              "(?=a)a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?aaaaaaaaaaaaaaaaaaaa" :
+              "a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?aaaaaaaaaaaaaaaaaaaa(a{0})*",
               op));
       assert(false);
     } catch (const std::regex_error &e) {
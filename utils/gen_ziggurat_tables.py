@@ -0,0 +1,159 @@
+#!/usr/bin/env python
+#===----------------------------------------------------------------------===##
+#
+#                     The LLVM Compiler Infrastructure
+#
+# This file is dual licensed under the MIT and the University of Illinois Open
+# Source Licenses. See LICENSE.TXT for details.
+#
+#===----------------------------------------------------------------------===##
+
+"""Prints the tables of the Ziggurat method used by normal_distribution and
+exponential_distribution in <random>.
+
+The tables are those of Marsaglia and Tsang, "The Ziggurat Method for
+Generating Random Variables" (2000), with 256 layers.  They are computed in
+80-digit decimal arithmetic and rounded once to double, so that they do not
+depend on the floating-point library of the machine that builds libc++.
+"""
+
+from __future__ import print_function
+from decimal import Decimal, getcontext
+import math
+
+getcontext().prec = 80
+
+LAYERS = 256
+PI = Decimal('3.14159265358979323846264338327950288419716939937510'
+             '58209749445923078164062862089986280348253421170679')
+
+
+def erf(z):
+    total = Decimal(0)
+    term = z
+    n = 0
+    while True:
+        t = term / (2 * n + 1)
+        total += t
+        if abs(t) < Decimal(10) ** -75:
+            break
+        n += 1
+        term = -term * z * z / n
+    return 2 / PI.sqrt() * total
+
+
+class Normal(object):
+    name = 'n'
+    bits = 52
+
+    @staticmethod
+    def f(x):
+        return (-x * x / 2).exp()
+
+    @staticmethod
+    def finv(y):
+        return (-2 * y.ln()).sqrt()
+
+    @classmethod
+    def area(cls, r):
+        # The base layer: the rectangle under f(r) and the tail beyond r.
+        tail = (PI / 2).sqrt() * (1 - erf(r / Decimal(2).sqrt()))
+        return r * cls.f(r) + tail
+
+
+class Exponential(object):
+    name = 'e'
+    bits = 53
+
+    @staticmethod
+    def f(x):
+        return (-x).exp()
+
+    @staticmethod
+    def finv(y):
+        return -y.ln()
+
+    @classmethod
+    def area(cls, r):
+        return r * cls.f(r) + cls.f(r)
+
+
+def top_excess(dist, r):
+    """The area of the top layer less that of the others, or None if the
+    layers reach the top of the curve too early."""
+    v = dist.area(r)
+    x = r
+    for _ in range(LAYERS - 2):
+        y = v / x + dist.f(x)
+        if y >= 1:
+            return None
+        x = dist.finv(y)
+    return x * (1 - dist.f(x)) - v
+
+
+def solve(dist, lo, hi):
+    lo = Decimal(lo)
+    hi = Decimal(hi)
+    for _ in range(200):
+        mid = (lo + hi) / 2
+        t = top_excess(dist, mid)
+        if t is None or t < 0:
+            lo = mid
+        else:
+            hi = mid
+    return (lo + hi) / 2
+
+
+def tables(dist, r):
+    m = Decimal(2) ** dist.bits
+    v = dist.area(r)
+    q = v / dist.f(r)
+    k = [0] * LAYERS
+    w = [Decimal(0)] * LAYERS
+    f = [Decimal(0)] * LAYERS
+    k[0] = int(r / q * m)
+    k[1] = 0
+    w[0] = q / m
+    w[LAYERS - 1] = r / m
+    f[0] = Decimal(1)
+    f[LAYERS - 1] = dist.f(r)
+    x = r
+    t = r
+    for i in range(LAYERS - 2, 0, -1):
+        x = dist.finv(v / x + dist.f(x))
+        k[i + 1] = int(x / t * m)
+        t = x
+        f[i] = dist.f(x)
+        w[i] = x / m
+    return k, w, f
+
+
+def double(d):
+    return repr(float(str(d)))
+
+
+def print_array(kind, name, values, fmt, per_line):
+    print('template <class _Dp>')
+    print('const %s __ziggurat<_Dp>::%s[%d] = {' % (kind, name, LAYERS))
+    for i in range(0, LAYERS, per_line):
+        line = ', '.join(fmt(v) for v in values[i:i + per_line])
+        print('    ' + line + (',' if i + per_line < LAYERS else ''))
+    print('};')
+    print()
+
+
+def main():
+    for dist, lo, hi in ((Normal, '3.5', '3.8'), (Exponential, '7.5', '7.9')):
+        r = solve(dist, lo, hi)
+        k, w, f = tables(dist, r)
+        print('template <class _Dp>')
+        print('const double __ziggurat<_Dp>::__r%s_ = %s;' % (dist.name, double(r)))
+        print()
+        print_array('uint64_t', '__k%s_' % dist.name, k,
+                    lambda v: '0x%016xull' % v, 3)
+        print_array('double', '__w%s_' % dist.name, w, double, 3)
+        print_array('double', '__f%s_' % dist.name, f, double, 3)
+
+
+if __name__ == '__main__':
+    main()